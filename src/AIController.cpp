@@ -1,16 +1,16 @@
 #include "AIController.h"
-#include "Random.h"
 #include <algorithm>
 #include <cmath>
 
-AIController::AIController()
+AIController::AIController (Random random_)
+    : random (random_)
 {
     // Random personality factor for variation between AI tanks
-    personalityFactor = randomFloat (0.9f, 1.1f);
+    personalityFactor = random.nextFloat (0.9f, 1.1f);
 }
 
-void AIController::update (float dt, const Tank& myTank, const std::vector<const Tank*>& enemies,
-                           const std::vector<Shell>& shells, const std::vector<std::unique_ptr<Obstacle>>& obstacles,
+void AIController::update (float dt, const Tank& myTank, const std::vector<const Tank*>& enemies, uint32_t visibleEnemies,
+                           const ShellPool& shells, const ObstacleList& obstacles, const ObstacleTree& obstacleTree,
                            float arenaWidth, float arenaHeight)
 {
     moveInput = { 0, 0 };
@@ -28,7 +28,8 @@ void AIController::update (float dt, const Tank& myTank, const std::vector<const
     }
 
     // Find best target
-    const Tank* target = findBestTarget (myTank, enemies);
+    const Tank* target = findBestTarget (myTank, enemies, visibleEnemies);
+    bool targetVisible = target && ((visibleEnemies >> target->getPlayerIndex()) & 1);
 
     // Calculate desired movement
     Vec2 desiredDirection = { 0, 0 };
@@ -46,7 +47,7 @@ void AIController::update (float dt, const Tank& myTank, const std::vector<const
     desiredDirection = desiredDirection + collectibleSeek * 2.5f;
 
     // Avoid obstacles
-    Vec2 obstacleAvoid = avoidObstacles (myTank, obstacles);
+    Vec2 obstacleAvoid = avoidObstacles (myTank, obstacles, obstacleTree);
     desiredDirection = desiredDirection + obstacleAvoid * 2.0f;
 
     // Avoid incoming shells
@@ -122,8 +123,8 @@ void AIController::update (float dt, const Tank& myTank, const std::vector<const
             aimInput = crosshairDiff.normalized();
         }
 
-        // Fire if on target and in range
-        if (targetDist < config.aiFireDistance * personalityFactor)
+        // Fire if on target, in range and not behind a wall - otherwise just keep tracking it
+        if (targetVisible && targetDist < config.aiFireDistance * personalityFactor)
         {
             if (crosshairDiff.length() < config.aiCrosshairTolerance * 2.0f)
             {
@@ -149,18 +150,22 @@ void AIController::update (float dt, const Tank& myTank, const std::vector<const
 void AIController::pickNewWanderTarget (float arenaWidth, float arenaHeight)
 {
     float margin = config.aiWanderMargin;
-    wanderTarget.x = randomFloat (margin, arenaWidth - margin);
-    wanderTarget.y = randomFloat (margin, arenaHeight - margin);
-    wanderTimer = config.aiWanderInterval * randomFloat (0.8f, 1.2f);
+    wanderTarget.x = random.nextFloat (margin, arenaWidth - margin);
+    wanderTarget.y = random.nextFloat (margin, arenaHeight - margin);
+    wanderTimer = config.aiWanderInterval * random.nextFloat (0.8f, 1.2f);
 }
 
-Vec2 AIController::avoidObstacles (const Tank& myTank, const std::vector<std::unique_ptr<Obstacle>>& obstacles) const
+Vec2 AIController::avoidObstacles (const Tank& myTank, const ObstacleList& obstacles, const ObstacleTree& obstacleTree) const
 {
     Vec2 avoidance = { 0, 0 };
     Vec2 pos = myTank.getPosition();
 
-    for (const auto& obstacle : obstacles)
+    // Nothing further than the largest danger distance below can push us
+    obstacleTree.query (Bounds::around (pos, 350.0f), nearbyObstacles);
+
+    for (int index : nearbyObstacles)
     {
+        const Obstacle* obstacle = obstacles[(size_t) index];
         if (!obstacle->isAlive())
             continue;
 
@@ -183,22 +188,22 @@ Vec2 AIController::avoidObstacles (const Tank& myTank, const std::vector<std::un
     return avoidance;
 }
 
-Vec2 AIController::avoidShells (const Tank& myTank, const std::vector<Shell>& shells) const
+Vec2 AIController::avoidShells (const Tank& myTank, const ShellPool& shells) const
 {
     Vec2 avoidance = { 0, 0 };
     Vec2 pos = myTank.getPosition();
 
-    for (const auto& shell : shells)
+    for (size_t i = 0; i < shells.size(); ++i)
     {
-        if (!shell.isAlive())
+        if (!shells.isAlive (i))
             continue;
 
         // Don't dodge own shells
-        if (shell.getOwnerIndex() == myTank.getPlayerIndex())
+        if (shells.getOwnerIndex (i) == myTank.getPlayerIndex())
             continue;
 
-        Vec2 shellPos = shell.getPosition();
-        Vec2 shellVel = shell.getVelocity();
+        Vec2 shellPos = shells.getPosition (i);
+        Vec2 shellVel = shells.getVelocity (i);
 
         // Predict where shell will be
         Vec2 toMe = pos - shellPos;
@@ -226,7 +231,7 @@ Vec2 AIController::avoidShells (const Tank& myTank, const std::vector<Shell>& sh
     return avoidance;
 }
 
-const Tank* AIController::findBestTarget (const Tank& myTank, const std::vector<const Tank*>& enemies) const
+const Tank* AIController::findBestTarget (const Tank& myTank, const std::vector<const Tank*>& enemies, uint32_t visibleEnemies) const
 {
     const Tank* best = nullptr;
     float bestScore = -9999.0f;
@@ -245,6 +250,10 @@ const Tank* AIController::findBestTarget (const Tank& myTank, const std::vector<
 
         float score = distScore * 0.6f + healthScore * 0.4f;
 
+        // Anything in sight beats anything hidden
+        if (!((visibleEnemies >> enemy->getPlayerIndex()) & 1))
+            score -= 1.0f;
+
         if (score > bestScore)
         {
             bestScore = score;
@@ -255,21 +264,20 @@ const Tank* AIController::findBestTarget (const Tank& myTank, const std::vector<
     return best;
 }
 
-Vec2 AIController::getPlacementPosition (float arenaWidth, float arenaHeight) const
+Vec2 AIController::getPlacementPosition (float arenaWidth, float arenaHeight)
 {
     float margin = config.aiPlacementMargin;
-    return {
-        randomFloat (margin, arenaWidth - margin),
-        randomFloat (margin, arenaHeight - margin)
-    };
+    float x = random.nextFloat (margin, arenaWidth - margin);
+    float y = random.nextFloat (margin, arenaHeight - margin);
+    return { x, y };
 }
 
-float AIController::getPlacementAngle() const
+float AIController::getPlacementAngle()
 {
-    return randomFloat (0.0f, 2.0f * pi);
+    return random.nextFloat (0.0f, 2.0f * pi);
 }
 
-Vec2 AIController::seekCollectibles (const Tank& myTank, const std::vector<std::unique_ptr<Obstacle>>& obstacles) const
+Vec2 AIController::seekCollectibles (const Tank& myTank, const ObstacleList& obstacles) const
 {
     Vec2 seek = { 0, 0 };
     Vec2 pos = myTank.getPosition();
@@ -297,7 +305,7 @@ Vec2 AIController::seekCollectibles (const Tank& myTank, const std::vector<std::
         if (distScore > bestScore)
         {
             bestScore = distScore;
-            bestTarget = obstacle.get();
+            bestTarget = obstacle;
         }
     }
 
@@ -1,20 +1,24 @@
 #pragma once
 
 #include "Config.h"
+#include "ObstacleTree.h"
 #include "Obstacles/Obstacle.h"
-#include "Shell.h"
+#include "Random.h"
+#include "ShellPool.h"
 #include "Tank.h"
 #include "Vec2.h"
+#include <cstdint>
 #include <memory>
 #include <vector>
 
 class AIController
 {
 public:
-    AIController();
+    explicit AIController (Random random);
 
-    void update (float dt, const Tank& myTank, const std::vector<const Tank*>& enemies,
-                 const std::vector<Shell>& shells, const std::vector<std::unique_ptr<Obstacle>>& obstacles,
+    // visibleEnemies has a bit set for each player index this tank has a clear line to
+    void update (float dt, const Tank& myTank, const std::vector<const Tank*>& enemies, uint32_t visibleEnemies,
+                 const ShellPool& shells, const ObstacleList& obstacles, const ObstacleTree& obstacleTree,
                  float arenaWidth, float arenaHeight);
 
     Vec2 getMoveInput() const { return moveInput; }
@@ -22,10 +26,12 @@ public:
     bool getFireInput() const { return fireInput; }
 
     // For placement phase
-    Vec2 getPlacementPosition (float arenaWidth, float arenaHeight) const;
-    float getPlacementAngle() const;
+    Vec2 getPlacementPosition (float arenaWidth, float arenaHeight);
+    float getPlacementAngle();
 
 private:
+    Random random;
+
     Vec2 moveInput;
     Vec2 aimInput;
     bool fireInput = false;
@@ -35,9 +41,11 @@ private:
 
     float personalityFactor;  // Slight variation in behavior
 
+    mutable std::vector<int> nearbyObstacles;   // Scratch for tree queries
+
     void pickNewWanderTarget (float arenaWidth, float arenaHeight);
-    Vec2 avoidObstacles (const Tank& myTank, const std::vector<std::unique_ptr<Obstacle>>& obstacles) const;
-    Vec2 avoidShells (const Tank& myTank, const std::vector<Shell>& shells) const;
-    const Tank* findBestTarget (const Tank& myTank, const std::vector<const Tank*>& enemies) const;
-    Vec2 seekCollectibles (const Tank& myTank, const std::vector<std::unique_ptr<Obstacle>>& obstacles) const;
+    Vec2 avoidObstacles (const Tank& myTank, const ObstacleList& obstacles, const ObstacleTree& obstacleTree) const;
+    Vec2 avoidShells (const Tank& myTank, const ShellPool& shells) const;
+    const Tank* findBestTarget (const Tank& myTank, const std::vector<const Tank*>& enemies, uint32_t visibleEnemies) const;
+    Vec2 seekCollectibles (const Tank& myTank, const ObstacleList& obstacles) const;
 };
@@ -3,6 +3,7 @@
 
 #include <nlohmann/json.hpp>
 #include <fstream>
+#include <iterator>
 
 using json = nlohmann::json;
 
@@ -95,15 +96,15 @@ bool Config::load()
     if (! file.is_open())
         return false;
 
-    json j;
-    try
-    {
-        file >> j;
-    }
-    catch (...)
-    {
+    std::string text ((std::istreambuf_iterator<char> (file)), std::istreambuf_iterator<char>());
+    return fromJson (text);
+}
+
+bool Config::fromJson (const std::string& text)
+{
+    json j = json::parse (text, nullptr, false);
+    if (j.is_discarded() || ! j.is_object())
         return false;
-    }
 
     auto getSection = [&j] (const char* name) -> const json& {
         static const json empty = json::object();
@@ -196,6 +197,7 @@ bool Config::load()
         loadValue (s, "smokeDamageMultiplier", smokeDamageMultiplier);
         loadValue (s, "smokeBaseRadius", smokeBaseRadius);
         loadValue (s, "smokeBaseAlpha", smokeBaseAlpha);
+        loadValue (s, "particleBudget", particleBudget);
         loadValue (s, "trackMarkFadeTime", trackMarkFadeTime);
         loadValue (s, "trackMarkSpawnDistance", trackMarkSpawnDistance);
         loadValue (s, "trackMarkWidth", trackMarkWidth);
@@ -248,6 +250,35 @@ bool Config::load()
         loadValue (s, "stalemateTimeout", stalemateTimeout);
     }
 
+    // Selection
+    {
+        const auto& s = getSection ("selection");
+        loadValue (s, "selectionTime", selectionTime);
+        loadValue (s, "aiMinDelay", aiSelectionMinDelay);
+        loadValue (s, "aiMaxDelay", aiSelectionMaxDelay);
+        loadValue (s, "aiMoveInterval", aiSelectionMoveInterval);
+    }
+
+    // Timing
+    {
+        const auto& s = getSection ("timing");
+        loadValue (s, "simTickRate", simTickRate);
+        loadValue (s, "maxFrameTime", maxFrameTime);
+        loadValue (s, "targetFps", targetFps);
+    }
+
+    // Display
+    {
+        const auto& s = getSection ("display");
+        loadValue (s, "renderScale", renderScale);
+        loadValue (s, "renderScaleSmooth", renderScaleSmooth);
+        loadValue (s, "dynamicRenderScale", dynamicRenderScale);
+        loadValue (s, "dynamicRenderScaleMin", dynamicRenderScaleMin);
+        loadValue (s, "targetFrameTime", targetFrameTime);
+        loadValue (s, "effectQualityGovernor", effectQualityGovernor);
+    }
+
+    generation++;
     return true;
 }
 
@@ -257,6 +288,16 @@ bool Config::save() const
     if (path.empty())
         return false;
 
+    std::ofstream file (path);
+    if (! file.is_open())
+        return false;
+
+    file << toJson();
+    return true;
+}
+
+std::string Config::toJson() const
+{
     json j;
 
     j["version"] = "1.0.0";
@@ -340,6 +381,7 @@ bool Config::save() const
         { "smokeDamageMultiplier", smokeDamageMultiplier },
         { "smokeBaseRadius", smokeBaseRadius },
         { "smokeBaseAlpha", smokeBaseAlpha },
+        { "particleBudget", particleBudget },
         { "trackMarkFadeTime", trackMarkFadeTime },
         { "trackMarkSpawnDistance", trackMarkSpawnDistance },
         { "trackMarkWidth", trackMarkWidth },
@@ -388,12 +430,32 @@ bool Config::save() const
         { "stalemateTimeout", stalemateTimeout }
     };
 
-    std::ofstream file (path);
-    if (! file.is_open())
-        return false;
+    // Selection
+    j["selection"] = {
+        { "selectionTime", selectionTime },
+        { "aiMinDelay", aiSelectionMinDelay },
+        { "aiMaxDelay", aiSelectionMaxDelay },
+        { "aiMoveInterval", aiSelectionMoveInterval }
+    };
 
-    file << j.dump (4);
-    return true;
+    // Timing
+    j["timing"] = {
+        { "simTickRate", simTickRate },
+        { "maxFrameTime", maxFrameTime },
+        { "targetFps", targetFps }
+    };
+
+    // Display
+    j["display"] = {
+        { "renderScale", renderScale },
+        { "renderScaleSmooth", renderScaleSmooth },
+        { "dynamicRenderScale", dynamicRenderScale },
+        { "dynamicRenderScaleMin", dynamicRenderScaleMin },
+        { "targetFrameTime", targetFrameTime },
+        { "effectQualityGovernor", effectQualityGovernor }
+    };
+
+    return j.dump (4);
 }
 
 void Config::startWatching()
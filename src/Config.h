@@ -2,6 +2,7 @@
 
 #include "FileSystemWatcher.h"
 #include <raylib.h>
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -18,8 +19,15 @@ public:
 
     bool load();
     bool save() const;
+
+    // Serialise the tweakable values (same layout as config.json)
+    std::string toJson() const;
+    bool fromJson (const std::string& text);
     void startWatching();
 
+    // Bumped every time values are loaded, so anything built from them can tell it's stale
+    int getGeneration() const { return generation; }
+
     // FileSystemWatcher::Listener
     void fileChanged (const std::string& file, FileSystemWatcher::Event event) override;
 
@@ -103,6 +111,7 @@ public:
     float smokeDamageMultiplier       = 3.0f;
     float smokeBaseRadius             = 3.0f;
     float smokeBaseAlpha              = 0.5f;
+    int particleBudget                = 4096;       // Max smoke puffs alive at once
 
     // -------------------------------------------------------------------------
     // Track Marks
@@ -158,6 +167,23 @@ public:
     int pointsForKill                 = 1;
     float stalemateTimeout            = 60.0f;      // Round ends in draw if no damage for this long
 
+    // -------------------------------------------------------------------------
+    // Timing
+    // -------------------------------------------------------------------------
+    float simTickRate                 = 120.0f;     // Fixed simulation steps per second
+    float maxFrameTime                = 0.25f;      // Longest real frame fed to the simulation (avoids spiral of death)
+    int targetFps                     = 0;          // Render frame cap, 0 = sync to display refresh
+
+    // -------------------------------------------------------------------------
+    // Display
+    // -------------------------------------------------------------------------
+    float renderScale                 = 1.0f;       // Arena drawn at this fraction of window resolution (0.25-1)
+    bool renderScaleSmooth            = true;       // Bilinear upscale, false for nearest
+    bool dynamicRenderScale           = false;      // Drop below renderScale when frames run long
+    float dynamicRenderScaleMin       = 0.5f;       // Lowest scale the dynamic mode will go to
+    float targetFrameTime             = 16.6f;      // Milliseconds the dynamic scale and effect governor try to hold
+    bool effectQualityGovernor        = true;       // Thin out effects when frames run over targetFrameTime
+
     // -------------------------------------------------------------------------
     // Selection Phase
     // -------------------------------------------------------------------------
@@ -260,6 +286,7 @@ private:
     std::string getConfigDirectory() const;
 
     std::unique_ptr<FileSystemWatcher> watcher;
+    std::atomic<int> generation = 0;
 };
 
 // Global config instance
@@ -0,0 +1,75 @@
+#include "ForceField.h"
+#include "Obstacles/Obstacle.h"
+#include <algorithm>
+#include <cmath>
+
+void ForceField::update (const ObstacleList& obstacles, float arenaWidth, float arenaHeight)
+{
+    scratch.clear();
+    for (const auto& obstacle : obstacles)
+        if (obstacle->isEmittingForce())
+            scratch.push_back (obstacle);
+
+    if (scratch == emitters && arenaWidth == width && arenaHeight == height)
+        return;
+
+    emitters.swap (scratch);
+    width = arenaWidth;
+    height = arenaHeight;
+    bake();
+}
+
+void ForceField::bake()
+{
+    if (emitters.empty())
+    {
+        samples.clear();
+        return;
+    }
+
+    columns = std::max (1, (int) std::ceil (width / CELL_SIZE));
+    rows = std::max (1, (int) std::ceil (height / CELL_SIZE));
+    samples.assign ((size_t) (columns + 1) * (rows + 1), Sample());
+
+    for (int y = 0; y <= rows; ++y)
+    {
+        for (int x = 0; x <= columns; ++x)
+        {
+            Vec2 point = { x * CELL_SIZE, y * CELL_SIZE };
+            Sample& s = samples[(size_t) y * (columns + 1) + x];
+
+            for (const Obstacle* emitter : emitters)
+            {
+                s.shell += emitter->getShellForce (point);
+                s.tank += emitter->getTankForce (point);
+            }
+        }
+    }
+}
+
+ForceField::Sample ForceField::sample (Vec2 position) const
+{
+    if (samples.empty())
+        return {};
+
+    float gx = std::clamp (position.x / CELL_SIZE, 0.0f, (float) columns);
+    float gy = std::clamp (position.y / CELL_SIZE, 0.0f, (float) rows);
+
+    int x0 = std::min ((int) gx, columns - 1);
+    int y0 = std::min ((int) gy, rows - 1);
+    float fx = gx - x0;
+    float fy = gy - y0;
+
+    size_t stride = (size_t) columns + 1;
+    const Sample& s00 = samples[(size_t) y0 * stride + x0];
+    const Sample& s10 = samples[(size_t) y0 * stride + x0 + 1];
+    const Sample& s01 = samples[(size_t) (y0 + 1) * stride + x0];
+    const Sample& s11 = samples[(size_t) (y0 + 1) * stride + x0 + 1];
+
+    auto lerp = [] (Vec2 a, Vec2 b, float t) { return a + (b - a) * t; };
+
+    Sample result;
+    result.shell = lerp (lerp (s00.shell, s10.shell, fx), lerp (s01.shell, s11.shell, fx), fy);
+    result.tank = lerp (lerp (s00.tank, s10.tank, fx), lerp (s01.tank, s11.tank, fx), fy);
+    return result;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Obstacles/Obstacle.h"
+#include "Vec2.h"
+#include <vector>
+
+// =============================================================================
+// ForceField
+// The combined push/pull of every active fan and electromagnet, baked into a
+// grid of samples and read back with bilinear interpolation. The grid is only
+// re-baked when the set of active emitters changes - placed, destroyed or a
+// magnet switching on or off - so per-shell and per-tank lookups never touch
+// the obstacles themselves.
+// =============================================================================
+
+class ForceField
+{
+public:
+    static constexpr float CELL_SIZE = 8.0f;
+
+    // Re-bake if the active emitters or the arena size changed since the last call
+    void update (const ObstacleList& obstacles, float arenaWidth, float arenaHeight);
+
+    // Force a re-bake on the next update - call when obstacles are added or removed
+    void invalidate() { emitters.clear(); width = 0.0f; }
+
+    bool isEmpty() const { return emitters.empty(); }
+
+    Vec2 getShellForce (Vec2 position) const { return sample (position).shell; }
+    Vec2 getTankForce (Vec2 position) const  { return sample (position).tank; }
+
+private:
+    struct Sample
+    {
+        Vec2 shell;
+        Vec2 tank;
+    };
+
+    std::vector<const Obstacle*> emitters;      // Active emitters the grid was baked from
+    std::vector<const Obstacle*> scratch;
+    std::vector<Sample> samples;                // (columns + 1) * (rows + 1) grid points
+    int columns = 0;
+    int rows = 0;
+    float width = 0.0f;
+    float height = 0.0f;
+
+    void bake();
+    Sample sample (Vec2 position) const;
+};
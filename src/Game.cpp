@@ -1,18 +1,47 @@
 #include "Game.h"
-#include "Random.h"
 #include <raylib.h>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdio>
 
 Game::Game() = default;
 
+Game::Game (const GameOptions& options_)
+    : options (options_)
+{
+}
+
 Game::~Game() = default;
 
 bool Game::init()
 {
-    SetConfigFlags (FLAG_WINDOW_RESIZABLE | FLAG_MSAA_4X_HINT);
+    if (! options.replayPath.empty() && ! loadReplay())
+        return false;
+
+    for (int i = 0; i < MAX_PLAYERS; ++i)
+    {
+        players[i] = std::make_unique<Player> (i);
+    }
+
+    if (options.noRender)
+    {
+        // Headless playback, the arena size comes from the recording
+        world = std::make_unique<World> ((float) currentTick.arenaWidth, (float) currentTick.arenaHeight, playback->getHeader().seed);
+        state = GameState::Title;
+        running = true;
+        return true;
+    }
+
+    unsigned int flags = FLAG_WINDOW_RESIZABLE | FLAG_MSAA_4X_HINT;
+    if (config.targetFps <= 0 && ! options.uncapped)
+        flags |= FLAG_VSYNC_HINT;
+
+    SetConfigFlags (flags);
     InitWindow (WINDOW_WIDTH, WINDOW_HEIGHT, "Cambrai");
-    SetTargetFPS (60);
+
+    if (config.targetFps > 0 && ! options.uncapped)
+        SetTargetFPS (config.targetFps);
     HideCursor();
 
     renderer = std::make_unique<Renderer>();
@@ -23,15 +52,15 @@ bool Game::init()
         audio.reset();
     }
 
-    for (int i = 0; i < MAX_PLAYERS; ++i)
-    {
-        players[i] = std::make_unique<Player> (i);
-    }
-    for (int i = 0; i < MAX_TANKS; ++i)
+    if (! playback)
     {
-        aiControllers[i] = std::make_unique<AIController>();
+        currentTick.arenaWidth = GetScreenWidth();
+        currentTick.arenaHeight = GetScreenHeight();
     }
 
+    uint64_t seed = playback ? playback->getHeader().seed : Random::makeSeed();
+    world = std::make_unique<World> ((float) currentTick.arenaWidth, (float) currentTick.arenaHeight, seed);
+
     state = GameState::Title;
     running = true;
     lastFrameTime = GetTime();
@@ -41,39 +70,113 @@ bool Game::init()
 
 void Game::run()
 {
+    if (options.noRender)
+    {
+        runHeadless();
+        return;
+    }
+
+    if (options.uncapped)
+    {
+        runUncapped();
+        return;
+    }
+
+    double startTime = GetTime();
+
     while (running && !WindowShouldClose())
     {
         double currentTime = GetTime();
-        float dt = (float) (currentTime - lastFrameTime);
+        double frameTime = currentTime - lastFrameTime;
         lastFrameTime = currentTime;
 
-        if (dt > 0.1f)
-            dt = 0.1f;
+        // Don't try to catch up after a long stall (window drag, debugger)
+        if (frameTime > config.maxFrameTime)
+            frameTime = config.maxFrameTime;
 
         handleEvents();
-        update (dt);
+        pollInput();
+
+        // Advance the simulation in fixed steps, carrying the remainder over to the next frame
+        float tickDt = 1.0f / std::max (config.simTickRate, 1.0f);
+        tickAccumulator += frameTime;
+
+        while (running && tickAccumulator >= tickDt)
+        {
+            update (tickDt);
+            tickAccumulator -= tickDt;
+        }
+
+        renderer->setInterpolation ((float) (tickAccumulator / tickDt));
+        renderer->updateRenderScale ((float) frameTime);
+        if (qualityGovernor.update ((float) frameTime))
+        {
+            const QualityTier& tier = qualityGovernor.getTier();
+            world->setEffectDensity ({ tier.smokeIntervalScale, tier.trackMarkSpacingScale });
+            renderer->setEffectDetail (tier.trailSegmentFraction, tier.explosionRings);
+        }
         render();
     }
+
+    if (playback)
+        reportPlayback (GetTime() - startTime);
+}
+
+void Game::runUncapped()
+{
+    // No frame pacing - run a batch of steps, draw the latest one, repeat
+    float tickDt = 1.0f / std::max (config.simTickRate, 1.0f);
+    int stepsPerFrame = std::max (options.renderEvery, 1);
+    double startTime = GetTime();
+
+    while (running && !WindowShouldClose())
+    {
+        handleEvents();
+        pollInput();
+
+        for (int i = 0; i < stepsPerFrame && running; ++i)
+            update (tickDt);
+
+        renderer->setInterpolation (1.0f);
+        render();
+    }
+
+    if (playback)
+        reportPlayback (GetTime() - startTime);
+}
+
+void Game::runHeadless()
+{
+    float tickDt = 1.0f / std::max (config.simTickRate, 1.0f);
+    auto startTime = std::chrono::steady_clock::now();
+
+    while (running)
+        update (tickDt);
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    reportPlayback (elapsed.count());
 }
 
 void Game::shutdown()
 {
-    tanks = {};
+    finishRecording();
+
+    world.reset();
     players = {};
-    aiControllers = {};
     renderer.reset();
     if (audio)
         audio->shutdown();
     audio.reset();
 
-    CloseWindow();
+    if (! options.noRender)
+        CloseWindow();
 }
 
 void Game::handleEvents()
 {
     if (IsKeyPressed (KEY_ESCAPE))
     {
-        if (state == GameState::Title)
+        if (state == GameState::Title || playback)
             running = false;
         else
         {
@@ -90,8 +193,19 @@ void Game::update (float dt)
     if (audio)
         audio->update (dt);
 
-    for (int i = 0; i < MAX_PLAYERS; ++i)
-        players[i]->update();
+    if (! readTickInput())
+    {
+        running = false;
+        return;
+    }
+
+    if (recorder.isRecording())
+        recorder.addTick (currentTick);
+
+    // The arena follows the window
+    float w, h;
+    getWindowSize (w, h);
+    world->setArenaSize (w, h);
 
     switch (state)
     {
@@ -114,17 +228,36 @@ void Game::update (float dt)
             updateGameOver (dt);
             break;
     }
+
+    // Button presses have been consumed by this step
+    for (int i = 0; i < MAX_PLAYERS; ++i)
+        players[i]->clearPressedInputs();
+    anyButtonLatched = false;
+}
+
+void Game::pollInput()
+{
+    if (playback)
+        return;
+
+    // Poll once per rendered frame, held inputs are sampled by every step and
+    // presses stay latched until a step runs
+    for (int i = 0; i < MAX_PLAYERS; ++i)
+        players[i]->update();
+
+    if (pollAnyButton())
+        anyButtonLatched = true;
 }
 
 void Game::updateTitle (float dt)
 {
     if (anyButtonPressed())
     {
-        startSelection();
+        startMatch();
     }
 }
 
-bool Game::anyButtonPressed()
+bool Game::pollAnyButton() const
 {
     if (IsMouseButtonPressed (MOUSE_BUTTON_LEFT))
         return true;
@@ -226,7 +359,7 @@ void Game::startSelection()
         // AI selection timing
         aiSelectionMoveTimer[i] = config.aiSelectionMoveInterval;
         aiSelectionConfirmTimer[i] = config.aiSelectionMinDelay +
-            randomFloat() * (config.aiSelectionMaxDelay - config.aiSelectionMinDelay);
+            world->getAIRandom().nextFloat() * (config.aiSelectionMaxDelay - config.aiSelectionMinDelay);
     }
 
     state = GameState::Selection;
@@ -324,7 +457,7 @@ void Game::updateSelection (float dt)
                 aiSelectionMoveTimer[i] = config.aiSelectionMoveInterval;
 
                 // Random move direction
-                int dir = randomInt (4);  // 0=left, 1=right, 2=up, 3=down
+                int dir = world->getAIRandom().nextInt (4);  // 0=left, 1=right, 2=up, 3=down
                 int col = selectionCursorIndex[i] % 4;
                 int row = selectionCursorIndex[i] / 4;
 
@@ -395,11 +528,6 @@ void Game::renderSelection()
     float w, h;
     getWindowSize (w, h);
 
-    // Draw timer
-    int seconds = (int) std::ceil (selectionTimer);
-    std::string timerText = "SELECT YOUR OBSTACLE: " + std::to_string (seconds);
-    renderer->drawTextCentered (timerText, { w / 2.0f, 40.0f }, 3.0f, config.colorPlacementTimer);
-
     // Grid layout: 4 columns x 3 rows
     const int cols = 4;
     const int rows = 3;
@@ -412,7 +540,33 @@ void Game::renderSelection()
     float gridStartX = (w - gridWidth) / 2.0f;
     float gridStartY = (h - gridHeight) / 2.0f - 20.0f;
 
-    // Draw grid cells
+    // Which player took each cell, -1 if nobody has
+    std::array<int, cols * rows> takenBy;
+    takenBy.fill (-1);
+    for (int p = 0; p < MAX_PLAYERS; ++p)
+        if (hasSelected[p] && takenBy[(size_t) selectedObstacleIndex[p]] < 0)
+            takenBy[(size_t) selectedObstacleIndex[p]] = p;
+
+    // Draw cell backgrounds and obstacle previews, all from baked thumbnails
+    std::array<Renderer::ObstacleThumbnail, cols * rows> thumbnails;
+    for (int idx = 0; idx < cols * rows; ++idx)
+    {
+        float cellX = gridStartX + (idx % cols) * (cellWidth + cellSpacing);
+        float cellY = gridStartY + (idx / cols) * (cellHeight + cellSpacing);
+
+        thumbnails[(size_t) idx] = { indexToObstacleType (idx), { cellX, cellY, cellWidth, cellHeight }, takenBy[(size_t) idx] >= 0 };
+    }
+    renderer->drawObstacleThumbnails (thumbnails);
+
+    // Text and cursors go over the grid at full resolution
+    renderer->setLayer (RenderLayer::Overlay);
+
+    // Draw timer
+    int seconds = (int) std::ceil (selectionTimer);
+    std::string timerText = "SELECT YOUR OBSTACLE: " + std::to_string (seconds);
+    renderer->drawTextCentered (timerText, { w / 2.0f, 40.0f }, 3.0f, config.colorPlacementTimer);
+
+    // Draw grid cell labels
     for (int row = 0; row < rows; ++row)
     {
         for (int col = 0; col < cols; ++col)
@@ -422,36 +576,11 @@ void Game::renderSelection()
             float cellX = gridStartX + col * (cellWidth + cellSpacing);
             float cellY = gridStartY + row * (cellHeight + cellSpacing);
 
-            // Determine cell state
-            bool isTaken = false;
-            int takenByPlayer = -1;
-            for (int p = 0; p < MAX_PLAYERS; ++p)
-            {
-                if (hasSelected[p] && selectedObstacleIndex[p] == idx)
-                {
-                    isTaken = true;
-                    takenByPlayer = p;
-                    break;
-                }
-            }
-
-            // Draw cell background
-            Color cellColor = isTaken ? config.colorSelectionTaken : config.colorSelectionCell;
-            renderer->drawFilledRect ({ cellX, cellY }, cellWidth, cellHeight, cellColor);
-
-            // Draw obstacle preview (clipped to cell)
-            Vec2 previewPos = { cellX + cellWidth / 2.0f, cellY + cellHeight / 2.0f - 10.0f };
-            ObstacleType obstacleType = indexToObstacleType (idx);
-
-            // Create temporary obstacle for drawing with clipping
-            BeginScissorMode ((int) cellX, (int) cellY, (int) cellWidth, (int) cellHeight);
-            auto preview = createObstacle (obstacleType, previewPos, 0.0f, -1);
-            preview->draw (*renderer);
-            EndScissorMode();
+            int takenByPlayer = takenBy[(size_t) idx];
+            bool isTaken = takenByPlayer >= 0;
 
             // Draw obstacle name
-            std::string name = obstacleTypeName (obstacleType);
-            renderer->drawTextCentered (name, { cellX + cellWidth / 2.0f, cellY + cellHeight - 15.0f },
+            renderer->drawTextCentered (obstacleTypeName (indexToObstacleType (idx)), { cellX + cellWidth / 2.0f, cellY + cellHeight - 15.0f },
                                        1.5f, config.colorSelectionText);
 
             // If taken, show which player
@@ -536,35 +665,8 @@ void Game::renderSelection()
 
 void Game::startPlacement()
 {
-    // Shuffle starting positions
-    for (int i = MAX_TANKS - 1; i > 0; --i)
-    {
-        int j = randomInt (i + 1);
-        std::swap (startPositionOrder[i], startPositionOrder[j]);
-    }
-
-    // Create tanks at randomized starting positions
-    float tankSize = renderer->getTankSize();
-    for (int i = 0; i < MAX_TANKS; ++i)
-    {
-        int posIndex = startPositionOrder[i];
-        tanks[i] = std::make_unique<Tank> (i, getTankStartPosition (posIndex), getTankStartAngle (posIndex), tankSize);
-    }
-
-    shells.clear();
-    explosions.clear();
-
     // Clear all obstacles on round 1, otherwise just remove destroyed ones
-    if (currentRound == 1)
-        obstacles.clear();
-    else
-    {
-        // Remove destroyed obstacles (mines that exploded, breakable walls that were destroyed)
-        obstacles.erase (
-            std::remove_if (obstacles.begin(), obstacles.end(), [] (const std::unique_ptr<Obstacle>& o)
-                            { return !o->isAlive(); }),
-            obstacles.end());
-    }
+    world->prepareRound (currentRound == 1);
 
     // Use selected obstacles from selection phase
     for (int i = 0; i < MAX_PLAYERS; ++i)
@@ -630,45 +732,17 @@ void Game::updatePlacement (float dt)
             // Place obstacle
             if (players[i]->getPlaceInput())
             {
-                // Create temporary obstacle to check validity
-                auto temp = createObstacle (assignedObstacles[i], placementPositions[i], placementAngles[i], i);
-
-                std::vector<Tank*> tankPtrs;
-                for (auto& tank : tanks)
-                    if (tank) tankPtrs.push_back (tank.get());
-
-                if (temp->isValidPlacement (obstacles, tankPtrs, w, h))
-                {
-                    obstacles.push_back (createObstacle (assignedObstacles[i], placementPositions[i], placementAngles[i], i));
+                if (world->placeObstacle (assignedObstacles[i], placementPositions[i], placementAngles[i], i))
                     hasPlaced[i] = true;
-                }
             }
         }
         else
         {
             // AI placement - pick random valid position
-            for (int attempt = 0; attempt < 10; ++attempt)
-            {
-                Vec2 pos = aiControllers[i]->getPlacementPosition (w, h);
-                float angle = aiControllers[i]->getPlacementAngle();
-
-                auto temp = createObstacle (assignedObstacles[i], pos, angle, i);
-
-                std::vector<Tank*> tankPtrs;
-                for (auto& tank : tanks)
-                    if (tank) tankPtrs.push_back (tank.get());
-
-                if (temp->isValidPlacement (obstacles, tankPtrs, w, h))
-                {
-                    obstacles.push_back (createObstacle (assignedObstacles[i], pos, angle, i));
-                    hasPlaced[i] = true;
-                    break;
-                }
-            }
+            world->placeObstacleRandomly (assignedObstacles[i], i, 10);
 
             // If couldn't place after attempts, mark as placed anyway
-            if (!hasPlaced[i])
-                hasPlaced[i] = true;
+            hasPlaced[i] = true;
         }
     }
 
@@ -683,43 +757,17 @@ void Game::updatePlacement (float dt)
     // Auto-place for players who haven't placed when timer expires
     if (placementTimer <= 0 && !allPlaced)
     {
-        std::vector<Tank*> tankPtrs;
-        for (auto& tank : tanks)
-            if (tank) tankPtrs.push_back (tank.get());
-
         for (int i = 0; i < MAX_PLAYERS; ++i)
         {
             if (hasPlaced[i])
                 continue;
 
-            // Try current position first
-            auto temp = createObstacle (assignedObstacles[i], placementPositions[i], placementAngles[i], i);
-            if (temp->isValidPlacement (obstacles, tankPtrs, w, h))
-            {
-                obstacles.push_back (createObstacle (assignedObstacles[i], placementPositions[i], placementAngles[i], i));
-                hasPlaced[i] = true;
-            }
-            else
-            {
-                // Try random valid positions
-                for (int attempt = 0; attempt < 20; ++attempt)
-                {
-                    Vec2 pos = aiControllers[i]->getPlacementPosition (w, h);
-                    float angle = aiControllers[i]->getPlacementAngle();
+            // Try current position first, then random valid positions
+            if (! world->placeObstacle (assignedObstacles[i], placementPositions[i], placementAngles[i], i))
+                world->placeObstacleRandomly (assignedObstacles[i], i, 20);
 
-                    auto randTemp = createObstacle (assignedObstacles[i], pos, angle, i);
-                    if (randTemp->isValidPlacement (obstacles, tankPtrs, w, h))
-                    {
-                        obstacles.push_back (createObstacle (assignedObstacles[i], pos, angle, i));
-                        hasPlaced[i] = true;
-                        break;
-                    }
-                }
-
-                // If still couldn't place, mark as placed anyway (no obstacle placed)
-                if (!hasPlaced[i])
-                    hasPlaced[i] = true;
-            }
+            // If still couldn't place, mark as placed anyway (no obstacle placed)
+            hasPlaced[i] = true;
         }
         allPlaced = true;
     }
@@ -733,114 +781,36 @@ void Game::updatePlacement (float dt)
 void Game::startRound()
 {
     stateTimer = 0.0f;
-
-    // Reset kills for this round
-    for (int i = 0; i < MAX_PLAYERS; ++i)
-        kills[i] = 0;
-
-    // Reset stalemate detection
-    noDamageTimer = 0.0f;
-    for (int i = 0; i < MAX_TANKS; ++i)
-        lastTankHealth[i] = tanks[i] ? tanks[i]->getHealth() : 0.0f;
-
-    roundWinner = -1;
+    world->startRound();
     state = GameState::Playing;
 }
 
 void Game::updatePlaying (float dt)
 {
-    float arenaWidth, arenaHeight;
-    getWindowSize (arenaWidth, arenaHeight);
-
-    stateTimer += dt;
-
-    // Update tanks
-    for (int tankIdx = 0; tankIdx < MAX_TANKS; ++tankIdx)
+    std::array<TankInput, MAX_TANKS> inputs;
+    for (int i = 0; i < MAX_TANKS; ++i)
     {
-        if (! tanks[tankIdx] || ! tanks[tankIdx]->isVisible())
-            continue;
-
-        Vec2 moveInput, aimInput;
-        bool fireInput = false;
+        Player& player = *players[i];
+        TankInput& input = inputs[i];
 
-        bool isHumanControlled = players[tankIdx]->isConnected();
-
-        if (isHumanControlled)
-        {
-            moveInput = players[tankIdx]->getMoveInput();
-            aimInput = players[tankIdx]->getAimInput();
-            fireInput = (stateTimer > config.roundStartDelay) && players[tankIdx]->getFireInput();
-        }
-        else
-        {
-            // AI control
-            std::vector<const Tank*> enemies;
-            for (int j = 0; j < MAX_TANKS; ++j)
-                if (j != tankIdx && tanks[j] && tanks[j]->isAlive())
-                    enemies.push_back (tanks[j].get());
-
-            aiControllers[tankIdx]->update (dt, *tanks[tankIdx], enemies, shells, obstacles, arenaWidth, arenaHeight);
-            moveInput = aiControllers[tankIdx]->getMoveInput();
-            aimInput = aiControllers[tankIdx]->getAimInput();
-            fireInput = aiControllers[tankIdx]->getFireInput();
-        }
+        input.aiControlled = ! player.isConnected();
+        if (input.aiControlled)
+            continue;
 
-        tanks[tankIdx]->update (dt, moveInput, aimInput, fireInput, arenaWidth, arenaHeight);
+        input.move = player.getMoveInput();
+        input.aim = player.getAimInput();
+        input.fire = player.getFireInput();
 
         // Mouse aiming
-        if (isHumanControlled && players[tankIdx]->isUsingMouse())
-            tanks[tankIdx]->setCrosshairPosition (players[tankIdx]->getMousePosition());
-
-        // Collect shells
-        auto& pendingShells = tanks[tankIdx]->getPendingShells();
-        if (! pendingShells.empty() && audio)
+        if (player.isUsingMouse())
         {
-            audio->playCannon (tanks[tankIdx]->getPosition().x, arenaWidth);
+            input.hasCrosshairTarget = true;
+            input.crosshairTarget = player.getMousePosition();
         }
-
-        for (auto& shell : pendingShells)
-            shells.push_back (std::move (shell));
-
-        pendingShells.clear();
     }
 
-    // Update obstacles (auto turrets)
-    std::vector<Tank*> tankPtrs;
-    for (auto& tank : tanks)
-        if (tank && tank->isAlive()) tankPtrs.push_back (tank.get());
-
-    for (auto& obstacle : obstacles)
-    {
-        obstacle->update (dt, tankPtrs, arenaWidth, arenaHeight);
-
-        // Collect shells from auto turrets
-        auto& pendingShells = obstacle->getPendingShells();
-        for (auto& shell : pendingShells)
-            shells.push_back (std::move (shell));
-        pendingShells.clear();
-
-        // Apply obstacle forces to tanks (electromagnet, fan)
-        if (obstacle->isAlive())
-        {
-            for (auto& tank : tanks)
-            {
-                if (tank && tank->isAlive())
-                {
-                    Vec2 force = obstacle->getTankForce (*tank);
-                    tank->applyExternalForce (force);
-                }
-            }
-        }
-
-        // Handle collection effects (flag capture, health pack pickup)
-        auto effect = obstacle->consumeCollectionEffect();
-        if (effect.playerIndex >= 0 && effect.playerIndex < MAX_PLAYERS)
-        {
-            scores[effect.playerIndex] += effect.scoreToAdd;
-            if (effect.healthPercent > 0 && tanks[effect.playerIndex])
-                tanks[effect.playerIndex]->heal (effect.healthPercent);
-        }
-    }
+    world->update (dt, inputs);
+    playWorldEvents();
 
     // Update engine volume
     if (audio)
@@ -849,9 +819,10 @@ void Game::updatePlaying (float dt)
         int aliveCount = 0;
         for (int i = 0; i < MAX_TANKS; ++i)
         {
-            if (tanks[i] && tanks[i]->isAlive())
+            Tank* tank = world->getTank (i);
+            if (tank && tank->isAlive())
             {
-                totalThrottle += std::abs (tanks[i]->getThrottle());
+                totalThrottle += std::abs (tank->getThrottle());
                 aliveCount++;
             }
         }
@@ -859,394 +830,36 @@ void Game::updatePlaying (float dt)
         audio->setEngineVolume (config.audioEngineBaseVolume + avgThrottle * config.audioEngineThrottleBoost);
     }
 
-    // Update shells
-    updateShells (dt);
-
-    // Check collisions
-    checkCollisions();
-
-    // Update explosions
-    for (auto& explosion : explosions)
-        explosion.timer += dt;
-
-    explosions.erase (
-        std::remove_if (explosions.begin(), explosions.end(), [] (const Explosion& e)
-                        { return ! e.isAlive(); }),
-        explosions.end());
-
-    // Update stalemate timer
-    noDamageTimer += dt;
-
-    // Check round over
-    checkRoundOver();
-}
-
-void Game::updateShells (float dt)
-{
-    float arenaWidth, arenaHeight;
-    getWindowSize (arenaWidth, arenaHeight);
-
-    for (auto& shell : shells)
+    if (world->isRoundOver())
     {
-        if (!shell.isAlive())
-            continue;
-
-        // Apply forces from obstacles (fans, electromagnets)
-        for (auto& obstacle : obstacles)
-        {
-            if (!obstacle->isAlive())
-                continue;
-
-            Vec2 force = obstacle->getShellForce (shell.getPosition());
-            shell.applyForce (force, dt);
-        }
-
-        shell.update (dt);
-
-        Vec2 pos = shell.getPosition();
-
-        // Check arena bounds - destroy shell
-        if (pos.x < 0 || pos.x > arenaWidth || pos.y < 0 || pos.y > arenaHeight)
-        {
-            shell.kill();
-        }
+        stateTimer = 0.0f;
+        state = GameState::RoundOver;
     }
-
-    shells.erase (
-        std::remove_if (shells.begin(), shells.end(), [] (const Shell& s)
-                        { return ! s.isAlive(); }),
-        shells.end());
 }
 
-void Game::checkCollisions()
+void Game::playWorldEvents()
 {
-    float arenaWidth, arenaHeight;
-    getWindowSize (arenaWidth, arenaHeight);
-
-    // Shell-to-obstacle collisions
-    for (auto& shell : shells)
-    {
-        if (!shell.isAlive())
-            continue;
-
-        for (auto& obstacle : obstacles)
-        {
-            if (!obstacle->isAlive())
-                continue;
-
-            Vec2 collisionPoint, normal;
-            ShellHitResult result = obstacle->checkShellCollision (shell, collisionPoint, normal);
-
-            if (result != ShellHitResult::Miss)
-            {
-                if (result == ShellHitResult::Reflected)
-                {
-                    shell.reflect (normal);
-                    break;  // Only one reflection per frame
-                }
-                else if (result == ShellHitResult::Ricochet)
-                {
-                    // Create 5 shells with spread angles
-                    Vec2 shellVel = shell.getVelocity();
-                    float speed = shellVel.length();
-
-                    // Reflect base velocity
-                    float dot = shellVel.dot (normal);
-                    Vec2 reflectedVel = shellVel - normal * (2.0f * dot);
-                    float baseAngle = std::atan2 (reflectedVel.y, reflectedVel.x);
-
-                    // Spawn 5 shells with angles spread around the reflected direction
-                    float spreadAngles[5] = { -0.3f, -0.15f, 0.0f, 0.15f, 0.3f };
-                    for (int i = 0; i < 5; ++i)
-                    {
-                        float angle = baseAngle + spreadAngles[i];
-                        Vec2 newVel = { std::cos (angle) * speed, std::sin (angle) * speed };
-                        Vec2 spawnPos = collisionPoint + normal * 5.0f;
-                        shells.push_back (Shell (spawnPos, newVel, shell.getOwnerIndex(),
-                                                 shell.getMaxRange() * 0.5f, shell.getDamage() * 0.4f));
-                    }
-
-                    shell.kill();
-                    break;
-                }
-                else  // Destroyed
-                {
-                    // Damage destructible obstacles (breakable walls, turrets)
-                    obstacle->takeDamage (shell.getDamage());
-
-                    if (obstacle->createsExplosionOnHit())
-                    {
-                        Explosion explosion;
-                        explosion.position = collisionPoint;
-                        explosion.duration = config.explosionDuration;
-                        explosion.maxRadius = config.explosionMaxRadius;
-                        explosions.push_back (explosion);
-
-                        if (!obstacle->isAlive())
-                        {
-                            Explosion destroyExplosion;
-                            destroyExplosion.position = obstacle->getPosition();
-                            destroyExplosion.duration = config.destroyExplosionDuration;
-                            destroyExplosion.maxRadius = config.destroyExplosionMaxRadius;
-                            explosions.push_back (destroyExplosion);
-                        }
-
-                        if (audio)
-                            audio->playExplosion (collisionPoint.x, arenaWidth);
-                    }
-
-                    shell.kill();
-                }
-
-                if (!shell.isAlive())
-                    break;
-            }
-        }
-    }
-
-    // Shell-to-tank collisions (raycast along shell path)
-    for (auto& shell : shells)
-    {
-        if (!shell.isAlive())
-            continue;
-
-        Vec2 shellPrev = shell.getPreviousPosition();
-        Vec2 shellCur = shell.getPosition();
-
-        for (auto& tank : tanks)
-        {
-            if (!tank || !tank->isVisible())
-                continue;
-
-            Vec2 hitPoint;
-            if (renderer->checkTankHitLine (*tank, shellPrev, shellCur, hitPoint))
-            {
-                tank->takeDamage (shell.getDamage(), shell.getOwnerIndex());
-
-                Explosion explosion;
-                explosion.position = hitPoint;
-                explosion.duration = config.explosionDuration;
-                explosion.maxRadius = config.explosionMaxRadius;
-                explosions.push_back (explosion);
-
-                if (audio)
-                    audio->playExplosion (hitPoint.x, arenaWidth);
-
-                // Track kill (no points for self-kills)
-                if (!tank->isAlive() && shell.getOwnerIndex() >= 0 && shell.getOwnerIndex() < MAX_PLAYERS
-                    && tank->getPlayerIndex() != shell.getOwnerIndex())
-                {
-                    kills[shell.getOwnerIndex()]++;
-                    scores[shell.getOwnerIndex()] += config.pointsForKill;
-
-                    // Big explosion for destruction
-                    Explosion destroyExplosion;
-                    destroyExplosion.position = tank->getPosition();
-                    destroyExplosion.duration = config.destroyExplosionDuration;
-                    destroyExplosion.maxRadius = config.destroyExplosionMaxRadius;
-                    explosions.push_back (destroyExplosion);
-                }
-
-                shell.kill();
-                break;
-            }
-        }
-    }
-
-    // Tank-to-obstacle collisions
-    for (auto& tank : tanks)
-    {
-        if (!tank || !tank->isAlive())
-            continue;
-
-        for (auto& obstacle : obstacles)
-        {
-            if (!obstacle->isAlive())
-                continue;
-
-            Vec2 pushDir;
-            float pushDist;
-
-            if (obstacle->checkTankCollision (*tank, pushDir, pushDist))
-            {
-                if (obstacle->getType() == ObstacleType::Mine && obstacle->isArmed())
-                {
-                    // Mine explodes - instant kill
-                    tank->takeDamage (config.mineDamage, obstacle->getOwnerIndex());
-                    obstacle->takeDamage (9999.0f);
-
-                    Explosion explosion;
-                    explosion.position = obstacle->getPosition();
-                    explosion.duration = config.destroyExplosionDuration;
-                    explosion.maxRadius = config.destroyExplosionMaxRadius;
-                    explosions.push_back (explosion);
-
-                    if (audio)
-                        audio->playExplosion (obstacle->getPosition().x, arenaWidth);
-
-                    // Track kill (no points for self-kills)
-                    if (!tank->isAlive() && obstacle->getOwnerIndex() >= 0 && obstacle->getOwnerIndex() < MAX_PLAYERS
-                        && tank->getPlayerIndex() != obstacle->getOwnerIndex())
-                    {
-                        kills[obstacle->getOwnerIndex()]++;
-                        scores[obstacle->getOwnerIndex()] += config.pointsForKill;
-
-                        Explosion destroyExplosion;
-                        destroyExplosion.position = tank->getPosition();
-                        destroyExplosion.duration = config.destroyExplosionDuration;
-                        destroyExplosion.maxRadius = config.destroyExplosionMaxRadius;
-                        explosions.push_back (destroyExplosion);
-                    }
-                }
-                else
-                {
-                    // Let obstacle handle collision (pit traps, portal teleports, etc.)
-                    bool applyPush = obstacle->handleTankCollision (*tank, obstacles);
-
-                    if (applyPush)
-                    {
-                        tank->applyCollision (pushDir, pushDist, { 0, 0 });
-
-                        if (audio)
-                            audio->playCollision (tank->getPosition().x, arenaWidth);
-                    }
-                }
-            }
-        }
-    }
-
-    // Tank-to-tank collisions
-    for (int i = 0; i < MAX_TANKS; ++i)
-    {
-        if (!tanks[i] || !tanks[i]->isAlive())
-            continue;
-
-        for (int j = i + 1; j < MAX_TANKS; ++j)
-        {
-            if (!tanks[j] || !tanks[j]->isAlive())
-                continue;
-
-            Vec2 collisionPoint;
-            if (renderer->checkTankCollision (*tanks[i], *tanks[j], collisionPoint))
-            {
-                Vec2 diff = tanks[j]->getPosition() - tanks[i]->getPosition();
-                Vec2 normal = diff.normalized();
-
-                float pushDist = (tanks[i]->getSize() + tanks[j]->getSize()) * 0.3f;
-
-                Vec2 velA = tanks[i]->getVelocity();
-                Vec2 velB = tanks[j]->getVelocity();
-                Vec2 relVel = velA - velB;
-                float impulseStrength = relVel.dot (normal) * 0.5f * config.collisionRestitution;
-
-                Vec2 impulse = normal * impulseStrength;
-
-                tanks[i]->applyCollision (normal * -1.0f, pushDist, impulse * -1.0f);
-                tanks[j]->applyCollision (normal, pushDist, impulse);
-
-                // Collision damage
-                float impactSpeed = relVel.length();
-                float damage = impactSpeed * config.collisionDamageScale;
-                tanks[i]->takeDamage (damage, j);
-                tanks[j]->takeDamage (damage, i);
-
-                // Track kills from ramming
-                if (!tanks[i]->isAlive())
-                {
-                    kills[j]++;
-                    scores[j] += config.pointsForKill;
-
-                    Explosion destroyExplosion;
-                    destroyExplosion.position = tanks[i]->getPosition();
-                    destroyExplosion.duration = config.destroyExplosionDuration;
-                    destroyExplosion.maxRadius = config.destroyExplosionMaxRadius;
-                    explosions.push_back (destroyExplosion);
-                }
-                if (!tanks[j]->isAlive())
-                {
-                    kills[i]++;
-                    scores[i] += config.pointsForKill;
-
-                    Explosion destroyExplosion;
-                    destroyExplosion.position = tanks[j]->getPosition();
-                    destroyExplosion.duration = config.destroyExplosionDuration;
-                    destroyExplosion.maxRadius = config.destroyExplosionMaxRadius;
-                    explosions.push_back (destroyExplosion);
-                }
-
-                if (audio && impactSpeed > config.audioMinImpactForSound)
-                    audio->playCollision (collisionPoint.x, arenaWidth);
-            }
-        }
-    }
-}
+    if (! audio)
+        return;
 
-void Game::checkRoundOver()
-{
-    int aliveCount = 0;
-    int lastAlive = -1;
+    float arenaWidth = world->getArenaWidth();
 
-    // Check for damage taken (stalemate detection)
-    bool damageTaken = false;
-    for (int i = 0; i < MAX_TANKS; ++i)
+    for (const auto& event : world->getEvents())
     {
-        if (tanks[i] && tanks[i]->isAlive() && !tanks[i]->isDestroying())
+        switch (event.type)
         {
-            aliveCount++;
-            lastAlive = i;
-
-            float currentHealth = tanks[i]->getHealth();
-            if (currentHealth < lastTankHealth[i])
-                damageTaken = true;
-            lastTankHealth[i] = currentHealth;
+            case WorldEvent::Type::CannonFired: audio->playCannon (event.position.x, arenaWidth); break;
+            case WorldEvent::Type::Explosion:   audio->playExplosion (event.position.x, arenaWidth); break;
+            case WorldEvent::Type::Collision:   audio->playCollision (event.position.x, arenaWidth); break;
         }
     }
-
-    if (damageTaken)
-        noDamageTimer = 0.0f;
-
-    if (aliveCount <= 1)
-    {
-        roundWinner = lastAlive;
-
-        // Award survival point
-        if (roundWinner >= 0)
-            scores[roundWinner] += config.pointsForSurviving;
-
-        stateTimer = 0.0f;
-        state = GameState::RoundOver;
-    }
-    // Stalemate - no damage for too long
-    else if (aliveCount > 1 && noDamageTimer >= config.stalemateTimeout)
-    {
-        roundWinner = -1;  // Draw
-        stateTimer = 0.0f;
-        state = GameState::RoundOver;
-    }
 }
 
 void Game::updateRoundOver (float dt)
 {
     stateTimer += dt;
 
-    float arenaWidth, arenaHeight;
-    getWindowSize (arenaWidth, arenaHeight);
-
-    // Keep updating tanks for smoke effects
-    for (auto& tank : tanks)
-    {
-        if (tank && tank->isVisible())
-            tank->update (dt, { 0, 0 }, { 0, 0 }, false, arenaWidth, arenaHeight);
-    }
-
-    // Update explosions
-    for (auto& explosion : explosions)
-        explosion.timer += dt;
-
-    explosions.erase (
-        std::remove_if (explosions.begin(), explosions.end(), [] (const Explosion& e)
-                        { return ! e.isAlive(); }),
-        explosions.end());
+    world->updateRoundOver (dt);
 
     if (stateTimer >= config.roundOverDelay)
     {
@@ -1278,28 +891,24 @@ void Game::updateGameOver (float dt)
 
 void Game::resetGame()
 {
-    for (auto& tank : tanks)
-        tank.reset();
-
-    shells.clear();
-    explosions.clear();
-    obstacles.clear();
-
+    finishRecording();
+    world->reset (Random::makeSeed());
     currentRound = 0;
-    for (int i = 0; i < MAX_PLAYERS; ++i)
-    {
-        scores[i] = 0;
-        kills[i] = 0;
-    }
 }
 
 void Game::render()
 {
-    BeginDrawing();
-
     float w, h;
     getWindowSize (w, h);
-    renderer->drawDirt (time, w, h);
+
+    BeginDrawing();
+    renderer->beginScene (w, h);
+    renderer->setLayer (RenderLayer::World);
+
+    // Dirt and walls come from a cached layer - the title and selection screens show bare dirt
+    static const ObstacleList noObstacles;
+    bool showArena = state != GameState::Title && state != GameState::Selection;
+    renderer->drawStaticLayer (showArena ? world->getObstacles() : noObstacles, w, h);
 
     switch (state)
     {
@@ -1334,6 +943,9 @@ void Game::renderTitle()
     float w, h;
     getWindowSize (w, h);
 
+    // Title text stays sharp whatever the render scale
+    renderer->setLayer (RenderLayer::Overlay);
+
     renderer->drawTextCentered ("CAMBRAI", { w / 2.0f, h / 3.0f }, 8.0f, config.colorTitle);
 
     int connectedCount = 0;
@@ -1384,18 +996,18 @@ void Game::renderPlacement()
     float w, h;
     getWindowSize (w, h);
 
-    // Draw existing obstacles
-    for (const auto& obstacle : obstacles)
-    {
-        obstacle->draw (*renderer);
-    }
+    // Draw existing obstacles, walls and pits are already in the static layer
+    for (const auto& obstacle : world->getObstacles())
+        if (! Renderer::isStaticObstacle (*obstacle))
+            renderer->drawObstacle (*obstacle);
 
     // Draw tanks as grey ghosts during placement
-    for (const auto& tank : tanks)
-        if (tank)
+    for (int i = 0; i < MAX_TANKS; ++i)
+        if (Tank* tank = world->getTank (i))
             renderer->drawTankGhost (*tank);
 
-    // Draw placement previews for human players
+    // Draw placement previews for human players, over the ghost sprites
+    renderer->setLayer (RenderLayer::Effects);
     for (int i = 0; i < MAX_PLAYERS; ++i)
     {
         if (hasPlaced[i] || !players[i]->isConnected())
@@ -1403,14 +1015,13 @@ void Game::renderPlacement()
 
         auto preview = createObstacle (assignedObstacles[i], placementPositions[i], placementAngles[i], i);
 
-        std::vector<Tank*> tankPtrs;
-        for (auto& tank : tanks)
-            if (tank) tankPtrs.push_back (tank.get());
-
-        bool valid = preview->isValidPlacement (obstacles, tankPtrs, w, h);
-        preview->drawPreview (*renderer, valid);
+        bool valid = world->isValidPlacement (assignedObstacles[i], placementPositions[i], placementAngles[i], i);
+        renderer->drawObstaclePreview (*preview, valid);
     }
 
+    // Text goes over the arena at full resolution
+    renderer->setLayer (RenderLayer::Overlay);
+
     // Draw timer
     int seconds = (int) std::ceil (placementTimer);
     std::string timerText = "PLACE YOUR OBSTACLE: " + std::to_string (seconds);
@@ -1424,7 +1035,8 @@ void Game::renderPlacement()
     for (int i = 0; i < MAX_PLAYERS; ++i)
     {
         Vec2 pos = { startX + i * slotSpacing, slotY };
-        Color color = tanks[i] ? tanks[i]->getColor() : config.colorGrey;
+        Tank* tank = world->getTank (i);
+        Color color = tank ? tank->getColor() : config.colorGrey;
 
         std::string typeText;
         switch (assignedObstacles[i])
@@ -1455,45 +1067,46 @@ void Game::renderPlaying()
     getWindowSize (w, h);
 
     // Draw track marks first
-    for (const auto& tank : tanks)
-        if (tank && tank->isVisible())
-            renderer->drawTrackMarks (*tank);
+    renderer->drawTrackMarks (world->getParticles(), w, h);
 
-    // Draw obstacles
-    for (const auto& obstacle : obstacles)
-        obstacle->draw (*renderer);
+    // Draw obstacles that animate, the rest are in the static layer
+    for (const auto& obstacle : world->getObstacles())
+        if (! Renderer::isStaticObstacle (*obstacle))
+            renderer->drawObstacle (*obstacle);
 
     // Draw tanks
-    for (const auto& tank : tanks)
-        if (tank && tank->isVisible())
+    for (int i = 0; i < MAX_TANKS; ++i)
+        if (Tank* tank = world->getTank (i); tank && tank->isVisible())
             renderer->drawTank (*tank);
 
-    // Draw smoke
-    for (const auto& tank : tanks)
-        if (tank && tank->isVisible())
-            renderer->drawSmoke (*tank);
-
     // Draw shells
-    for (const auto& shell : shells)
-        renderer->drawShell (shell);
+    renderer->drawShells (world->getShells());
+
+    // Smoke and explosions are shapes, which would go under the tank and shell sprites on the World layer
+    renderer->setLayer (RenderLayer::Effects);
+
+    // Draw smoke
+    renderer->drawSmoke (world->getParticles());
 
     // Draw explosions
-    for (const auto& explosion : explosions)
-        renderer->drawExplosion (explosion);
+    renderer->drawExplosions (world->getParticles());
+
+    // Crosshairs, HUDs and anything after go over the arena
+    renderer->setLayer (RenderLayer::Overlay);
 
     // Draw crosshairs
-    for (const auto& tank : tanks)
-        if (tank && tank->isAlive())
+    for (int i = 0; i < MAX_TANKS; ++i)
+        if (Tank* tank = world->getTank (i); tank && tank->isAlive())
             renderer->drawCrosshair (*tank);
 
     // Draw HUDs
     float hudWidth = 150.0f;
     for (int i = 0; i < MAX_TANKS; ++i)
     {
-        if (tanks[i])
+        if (Tank* tank = world->getTank (i))
         {
-            float alpha = tanks[i]->isAlive() ? 1.0f : 0.4f;
-            renderer->drawTankHUD (*tanks[i], i, MAX_TANKS, w, hudWidth, alpha);
+            float alpha = tank->isAlive() ? 1.0f : 0.4f;
+            renderer->drawTankHUD (*tank, i, MAX_TANKS, w, hudWidth, alpha);
         }
     }
 
@@ -1509,9 +1122,10 @@ void Game::renderPlaying()
     for (int i = 0; i < MAX_TANKS; ++i)
     {
         Vec2 pos = { scoreStartX + i * scoreSpacing, scoreY };
-        Color color = tanks[i] ? tanks[i]->getColor() : config.colorGrey;
+        Tank* tank = world->getTank (i);
+        Color color = tank ? tank->getColor() : config.colorGrey;
 
-        std::string scoreStr = std::to_string (scores[i]);
+        std::string scoreStr = std::to_string (world->getScore (i));
         renderer->drawTextCentered (scoreStr, pos, 3.0f, color);
     }
 }
@@ -1521,6 +1135,7 @@ void Game::renderRoundOver()
     float w, h;
     getWindowSize (w, h);
 
+    int roundWinner = world->getRoundWinner();
     if (roundWinner >= 0)
     {
         std::string winText = "PLAYER " + std::to_string (roundWinner + 1) + " WINS ROUND " + std::to_string (currentRound);
@@ -1541,7 +1156,7 @@ void Game::renderGameOver()
     int winner = 0;
     for (int i = 1; i < MAX_PLAYERS; ++i)
     {
-        if (scores[i] > scores[winner])
+        if (world->getScore (i) > world->getScore (winner))
             winner = i;
     }
 
@@ -1552,7 +1167,7 @@ void Game::renderGameOver()
     std::string scoresText = "";
     for (int i = 0; i < MAX_PLAYERS; ++i)
     {
-        scoresText += "P" + std::to_string (i + 1) + ": " + std::to_string (scores[i]) + "  ";
+        scoresText += "P" + std::to_string (i + 1) + ": " + std::to_string (world->getScore (i)) + "  ";
     }
     renderer->drawTextCentered (scoresText, { w / 2.0f, h / 2.0f + 40.0f }, 2.5f, config.colorSubtitle);
 
@@ -1562,39 +1177,116 @@ void Game::renderGameOver()
     }
 }
 
-Vec2 Game::getTankStartPosition (int index) const
+void Game::getWindowSize (float& width, float& height) const
 {
-    float w, h;
-    getWindowSize (w, h);
+    // The arena size is part of each step's input, so a replay lays out the same
+    width = (float) currentTick.arenaWidth;
+    height = (float) currentTick.arenaHeight;
+}
 
-    // Place tanks in corners
-    float margin = 100.0f;
+// =============================================================================
+// Replays
+// =============================================================================
 
-    switch (index)
+bool Game::loadReplay()
+{
+    playback = std::make_unique<ReplayReader>();
+    if (! playback->load (options.replayPath))
     {
-        case 0: return { margin, margin };
-        case 1: return { w - margin, margin };
-        case 2: return { margin, h - margin };
-        case 3: return { w - margin, h - margin };
-        default: return { w / 2.0f, h / 2.0f };
+        TraceLog (LOG_ERROR, "Unable to read replay: %s", options.replayPath.c_str());
+        return false;
     }
+
+    // Play back under the settings the match was recorded with
+    const ReplayHeader& header = playback->getHeader();
+    if (! config.fromJson (header.configJson))
+        TraceLog (LOG_WARNING, "Replay has no usable config, using current settings");
+    config.simTickRate = header.tickRate;
+
+    // Peek at the first step for the initial arena size, then rewind
+    ReplayTick first;
+    if (playback->nextTick (first))
+    {
+        currentTick.arenaWidth = first.arenaWidth;
+        currentTick.arenaHeight = first.arenaHeight;
+    }
+    playback->load (options.replayPath);
+
+    if (currentTick.arenaWidth <= 0 || currentTick.arenaHeight <= 0)
+    {
+        currentTick.arenaWidth = WINDOW_WIDTH;
+        currentTick.arenaHeight = WINDOW_HEIGHT;
+    }
+
+    return true;
 }
 
-float Game::getTankStartAngle (int index) const
+bool Game::readTickInput()
 {
-    // Point tanks toward center
-    switch (index)
+    if (playback)
+    {
+        if (! playback->nextTick (currentTick))
+            return false;
+
+        for (int i = 0; i < MAX_PLAYERS; ++i)
+            players[i]->setInput (currentTick.players[i]);
+        anyButtonLatched = currentTick.anyButton;
+    }
+    else
     {
-        case 0: return pi * 0.25f;   // Top-left, point toward center
-        case 1: return pi * 0.75f;   // Top-right
-        case 2: return -pi * 0.25f;  // Bottom-left
-        case 3: return -pi * 0.75f;  // Bottom-right
-        default: return 0.0f;
+        // Quantize live input to what a replay stores so both runs see identical values
+        for (int i = 0; i < MAX_PLAYERS; ++i)
+        {
+            currentTick.players[i] = quantizeInput (players[i]->getInput());
+            players[i]->setInput (currentTick.players[i]);
+        }
+        currentTick.anyButton = anyButtonLatched;
+
+        if (! options.noRender)
+        {
+            currentTick.arenaWidth = GetScreenWidth();
+            currentTick.arenaHeight = GetScreenHeight();
+        }
     }
+
+    ticksRun++;
+    return true;
 }
 
-void Game::getWindowSize (float& width, float& height) const
+void Game::startMatch()
+{
+    // Each match gets its own seed, recorded so the replay can recreate it
+    uint64_t seed = playback ? playback->getHeader().seed : Random::makeSeed();
+    world->reset (seed);
+    currentRound = 0;
+
+    if (! playback)
+    {
+        ReplayHeader header;
+        header.seed = seed;
+        header.tickRate = config.simTickRate;
+        header.configJson = config.toJson();
+
+        recorder.begin (header);
+        recorder.addTick (currentTick);
+    }
+
+    startSelection();
+}
+
+void Game::finishRecording()
+{
+    if (! recorder.isRecording())
+        return;
+
+    std::string path = ReplayWriter::makeDefaultPath();
+    if (recorder.save (path))
+        TraceLog (LOG_INFO, "Replay saved: %s", path.c_str());
+}
+
+void Game::reportPlayback (double seconds) const
 {
-    width = (float) GetScreenWidth();
-    height = (float) GetScreenHeight();
+    double ticksPerSecond = seconds > 0.0 ? ticksRun / seconds : 0.0;
+    std::printf ("Replay: %u ticks in %.3f s (%.0f ticks/s, %.1fx real time)\n",
+                 ticksRun, seconds, ticksPerSecond, ticksPerSecond / std::max (config.simTickRate, 1.0f));
 }
@@ -1,15 +1,15 @@
 #pragma once
 
-#include "AIController.h"
 #include "Audio.h"
 #include "Config.h"
-#include "Obstacles/AllObstacles.h"
 #include "Player.h"
+#include "QualityGovernor.h"
 #include "Renderer.h"
-#include "Shell.h"
-#include "Tank.h"
+#include "Replay.h"
+#include "World.h"
 #include <array>
 #include <memory>
+#include <string>
 #include <vector>
 
 enum class GameState
@@ -22,21 +22,19 @@ enum class GameState
     GameOver      // After all rounds
 };
 
-struct Explosion
+struct GameOptions
 {
-    Vec2 position;
-    float timer = 0.0f;
-    float duration = 0.0f;
-    float maxRadius = 0.0f;
-
-    float getProgress() const { return timer / duration; }
-    bool isAlive() const { return timer < duration; }
+    std::string replayPath;     // Play this recording back instead of reading live input
+    bool uncapped = false;      // Step the simulation as fast as possible
+    int renderEvery = 1;        // When uncapped, draw one frame per this many steps
+    bool noRender = false;      // No window or audio, run the replay and report timing
 };
 
 class Game
 {
 public:
     Game();
+    explicit Game (const GameOptions& options);
     ~Game();
 
     bool init();
@@ -46,25 +44,32 @@ public:
 private:
     static constexpr int WINDOW_WIDTH = 1280;
     static constexpr int WINDOW_HEIGHT = 720;
-    static constexpr int MAX_TANKS = 4;
+    static constexpr int MAX_TANKS = World::MAX_TANKS;
     static constexpr int MAX_PLAYERS = 4;
 
     std::unique_ptr<Renderer> renderer;
     std::unique_ptr<Audio> audio;
+    std::unique_ptr<World> world;
+    QualityGovernor qualityGovernor;
 
+    GameOptions options;
     bool running = false;
     GameState state = GameState::Title;
     int currentRound = 0;
     float stateTimer = 0.0f;
     float time = 0.0f;
     double lastFrameTime = 0.0;
+    double tickAccumulator = 0.0;   // Real time not yet consumed by fixed simulation steps
+    bool anyButtonLatched = false;
 
-    std::array<std::unique_ptr<Tank>, MAX_TANKS> tanks;
     std::array<std::unique_ptr<Player>, MAX_PLAYERS> players;
-    std::array<std::unique_ptr<AIController>, MAX_TANKS> aiControllers;
-    std::vector<Shell> shells;
-    std::vector<Explosion> explosions;
-    std::vector<std::unique_ptr<Obstacle>> obstacles;
+
+    // Replays - every step's input is captured into currentTick, either from the
+    // players or from the file being played back
+    ReplayTick currentTick;
+    ReplayWriter recorder;
+    std::unique_ptr<ReplayReader> playback;
+    uint32_t ticksRun = 0;
 
     // Selection phase
     std::array<int, MAX_PLAYERS> selectionCursorIndex = {};   // Grid position (0-10)
@@ -83,26 +88,25 @@ private:
     std::array<float, MAX_PLAYERS> placementAngles;
     float placementTimer = 0.0f;
 
-    // Scoring
-    std::array<int, MAX_PLAYERS> scores = {};  // Total points
-    std::array<int, MAX_PLAYERS> kills = {};   // Kills this round
-    int roundWinner = -1;
-
-    // Stalemate detection
-    float noDamageTimer = 0.0f;
-    std::array<float, MAX_TANKS> lastTankHealth = {};
-
-    // Random starting positions (shuffled each round)
-    std::array<int, MAX_TANKS> startPositionOrder = { 0, 1, 2, 3 };
-
     void handleEvents();
+    void pollInput();
     void update (float dt);
     void render();
+    void runUncapped();
+    void runHeadless();
+
+    // Replays
+    bool loadReplay();
+    bool readTickInput();
+    void startMatch();
+    void finishRecording();
+    void reportPlayback (double seconds) const;
 
     // Title screen
     void updateTitle (float dt);
     void renderTitle();
-    bool anyButtonPressed();
+    bool anyButtonPressed() const { return anyButtonLatched; }
+    bool pollAnyButton() const;
 
     // Selection phase
     void startSelection();
@@ -122,9 +126,7 @@ private:
     void startRound();
     void updatePlaying (float dt);
     void renderPlaying();
-    void updateShells (float dt);
-    void checkCollisions();
-    void checkRoundOver();
+    void playWorldEvents();
 
     // Round over
     void updateRoundOver (float dt);
@@ -135,8 +137,6 @@ private:
     void renderGameOver();
     void resetGame();
 
-    Vec2 getTankStartPosition (int index) const;
-    float getTankStartAngle (int index) const;
     void getWindowSize (float& width, float& height) const;
     int getNumTanks() const { return MAX_TANKS; }
 };
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "Vec2.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+// Axis-aligned bounding box, used for broadphase culling
+struct Bounds
+{
+    Vec2 min;
+    Vec2 max;
+
+    // Inverted box - overlaps nothing
+    static Bounds empty()
+    {
+        constexpr float inf = std::numeric_limits<float>::infinity();
+        return { { inf, inf }, { -inf, -inf } };
+    }
+
+    static Bounds around (Vec2 centre, float radius)
+    {
+        return { { centre.x - radius, centre.y - radius }, { centre.x + radius, centre.y + radius } };
+    }
+
+    // Box covering a moving point's path, grown by its radius
+    static Bounds ofSegment (Vec2 start, Vec2 end, float radius)
+    {
+        return { { std::min (start.x, end.x) - radius, std::min (start.y, end.y) - radius },
+                 { std::max (start.x, end.x) + radius, std::max (start.y, end.y) + radius } };
+    }
+
+    template <typename Points>
+    static Bounds ofPoints (const Points& points)
+    {
+        Bounds b { points[0], points[0] };
+        for (const Vec2& p : points)
+        {
+            b.min.x = std::min (b.min.x, p.x);
+            b.min.y = std::min (b.min.y, p.y);
+            b.max.x = std::max (b.max.x, p.x);
+            b.max.y = std::max (b.max.y, p.y);
+        }
+        return b;
+    }
+
+    bool isEmpty() const { return min.x > max.x || min.y > max.y; }
+
+    bool operator== (const Bounds& other) const
+    {
+        return min.x == other.min.x && min.y == other.min.y && max.x == other.max.x && max.y == other.max.y;
+    }
+    Vec2 centre() const { return (min + max) * 0.5f; }
+
+    // Grow to cover another box, growing an empty box gives the other one
+    void expand (const Bounds& other)
+    {
+        min.x = std::min (min.x, other.min.x);
+        min.y = std::min (min.y, other.min.y);
+        max.x = std::max (max.x, other.max.x);
+        max.y = std::max (max.y, other.max.y);
+    }
+
+    Bounds grown (float amount) const
+    {
+        return { { min.x - amount, min.y - amount }, { max.x + amount, max.y + amount } };
+    }
+
+    bool overlaps (const Bounds& other) const
+    {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y;
+    }
+
+    bool contains (Vec2 p) const
+    {
+        return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y;
+    }
+
+    // Slab test - does the segment start + (end - start) * t, t in [0, 1], touch the box
+    bool intersectsSegment (Vec2 start, Vec2 end) const
+    {
+        float tMin = 0.0f;
+        float tMax = 1.0f;
+
+        auto slab = [&] (float origin, float delta, float lo, float hi)
+        {
+            if (std::abs (delta) < 1e-8f)
+                return origin >= lo && origin <= hi;
+
+            float t0 = (lo - origin) / delta;
+            float t1 = (hi - origin) / delta;
+            if (t0 > t1)
+                std::swap (t0, t1);
+
+            tMin = std::max (tMin, t0);
+            tMax = std::min (tMax, t1);
+            return tMin <= tMax;
+        };
+
+        return slab (start.x, end.x - start.x, min.x, max.x)
+            && slab (start.y, end.y - start.y, min.y, max.y);
+    }
+};
+
+// A rectangle turned to an angle, with everything the collision tests need worked
+// out when it moves rather than every time it's asked for. Corners go (-x, -y),
+// (x, -y), (x, y), (-x, y) in the box's own frame, with x along its angle
+struct OrientedBox
+{
+    Vec2 centre;
+    Vec2 halfSize;                      // Half the length along the angle, half the width across it
+    float angle = 0.0f;
+    float cosA = 1.0f;
+    float sinA = 0.0f;
+
+    std::array<Vec2, 4> corners;
+    std::array<Vec2, 2> edgeNormals;    // Across edges 0-1 and 0-3, the box's separating axes
+    Bounds bounds;
+
+    // The only place the trig happens, so only call it when the angle changes
+    void setAngle (float newAngle)
+    {
+        angle = newAngle;
+        cosA = std::cos (angle);
+        sinA = std::sin (angle);
+    }
+
+    void moveTo (Vec2 newCentre)
+    {
+        centre = newCentre;
+
+        const Vec2 local[4] = {
+            { -halfSize.x, -halfSize.y },
+            { halfSize.x, -halfSize.y },
+            { halfSize.x, halfSize.y },
+            { -halfSize.x, halfSize.y }
+        };
+
+        for (int i = 0; i < 4; ++i)
+        {
+            corners[i].x = centre.x + local[i].x * cosA - local[i].y * sinA;
+            corners[i].y = centre.y + local[i].x * sinA + local[i].y * cosA;
+        }
+
+        // Taken from the corners rather than the angle so they match them exactly
+        Vec2 along = (corners[1] - corners[0]).normalized();
+        Vec2 across = (corners[3] - corners[0]).normalized();
+        edgeNormals[0] = { -along.y, along.x };
+        edgeNormals[1] = { -across.y, across.x };
+
+        bounds = Bounds::ofPoints (corners);
+    }
+
+    Vec2 getAxisX() const { return { cosA, sinA }; }    // Along the angle
+    Vec2 getAxisY() const { return { -sinA, cosA }; }   // Across it
+};
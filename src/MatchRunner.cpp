@@ -0,0 +1,89 @@
+#include "MatchRunner.h"
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+    constexpr int NUM_OBSTACLE_TYPES = (int) ObstacleType::Fan + 1;
+
+    // Each player takes a different obstacle, as in the selection grid
+    std::array<ObstacleType, World::MAX_TANKS> selectObstacles (World& world)
+    {
+        std::array<ObstacleType, World::MAX_TANKS> selected;
+        std::array<bool, NUM_OBSTACLE_TYPES> taken = {};
+
+        for (int i = 0; i < World::MAX_TANKS; ++i)
+        {
+            int index = world.getAIRandom().nextInt (NUM_OBSTACLE_TYPES);
+            while (taken[index])
+                index = (index + 1) % NUM_OBSTACLE_TYPES;
+
+            taken[index] = true;
+            selected[i] = (ObstacleType) index;
+        }
+
+        return selected;
+    }
+}
+
+MatchResult runMatch (uint64_t seed, const MatchSettings& settings)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    MatchResult result;
+    result.seed = seed;
+
+    World world (settings.arenaWidth, settings.arenaHeight, seed);
+
+    int rounds = settings.rounds > 0 ? settings.rounds : config.roundsToWin;
+    float tickDt = 1.0f / std::max (config.simTickRate, 1.0f);
+
+    // No human players, every tank follows its AIController
+    std::array<TankInput, World::MAX_TANKS> inputs;
+
+    for (int round = 1; round <= rounds; ++round)
+    {
+        auto obstacles = selectObstacles (world);
+
+        world.prepareRound (round == 1);
+        for (int i = 0; i < World::MAX_TANKS; ++i)
+            world.placeObstacleRandomly (obstacles[i], i, 10);
+
+        world.startRound();
+
+        while (! world.isRoundOver() && world.getRoundTime() < settings.maxRoundTime)
+        {
+            world.update (tickDt, inputs);
+            result.ticks++;
+        }
+
+        RoundResult roundResult;
+        roundResult.winner = world.getRoundWinner();
+        roundResult.duration = world.getRoundTime();
+        for (int i = 0; i < World::MAX_TANKS; ++i)
+            roundResult.kills[i] = world.getKills (i);
+
+        result.rounds.push_back (roundResult);
+    }
+
+    int bestScore = -1;
+    for (int i = 0; i < World::MAX_TANKS; ++i)
+    {
+        result.scores[i] = world.getScore (i);
+
+        if (result.scores[i] > bestScore)
+        {
+            bestScore = result.scores[i];
+            result.winner = i;
+        }
+        else if (result.scores[i] == bestScore)
+        {
+            result.winner = -1;
+        }
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    result.wallSeconds = elapsed.count();
+
+    return result;
+}
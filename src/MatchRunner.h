@@ -0,0 +1,39 @@
+#pragma once
+
+#include "World.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// =============================================================================
+// MatchRunner
+// Plays a complete match headless with every slot driven by its AIController,
+// following the same flow as the game: select, place, fight, repeat.
+// =============================================================================
+
+struct MatchSettings
+{
+    float arenaWidth = 1280.0f;
+    float arenaHeight = 720.0f;
+    int rounds = 0;                 // 0 = config.roundsToWin
+    float maxRoundTime = 600.0f;    // Safety net in case a round never resolves
+};
+
+struct RoundResult
+{
+    int winner = -1;                // -1 = draw
+    float duration = 0.0f;
+    std::array<int, World::MAX_TANKS> kills = {};
+};
+
+struct MatchResult
+{
+    uint64_t seed = 0;
+    int winner = -1;                // Highest score, -1 if tied
+    std::array<int, World::MAX_TANKS> scores = {};
+    std::vector<RoundResult> rounds;
+    uint64_t ticks = 0;
+    double wallSeconds = 0.0;
+};
+
+MatchResult runMatch (uint64_t seed, const MatchSettings& settings);
@@ -0,0 +1,171 @@
+#include "ObstacleTree.h"
+#include <algorithm>
+
+void ObstacleTree::build (const std::vector<Bounds>& itemBounds)
+{
+    nodes.clear();
+    order.clear();
+    bounds = itemBounds;
+    itemLeaf.assign (itemBounds.size(), -1);
+
+    for (int i = 0; i < (int) itemBounds.size(); ++i)
+        if (! itemBounds[(size_t) i].isEmpty())
+            order.push_back (i);
+
+    if (order.empty())
+        return;
+
+    nodes.reserve (order.size() * 2 / maxLeafItems + 2);
+    buildNode (-1, 0, (int) order.size());
+}
+
+void ObstacleTree::clear()
+{
+    nodes.clear();
+    order.clear();
+    bounds.clear();
+    itemLeaf.clear();
+}
+
+int ObstacleTree::buildNode (int parent, int first, int count)
+{
+    int index = (int) nodes.size();
+    nodes.emplace_back();
+    nodes[(size_t) index].parent = parent;
+
+    Bounds box = Bounds::empty();
+    Bounds centres = Bounds::empty();
+    for (int i = first; i < first + count; ++i)
+    {
+        const Bounds& b = bounds[(size_t) order[(size_t) i]];
+        box.expand (b);
+        centres.expand ({ b.centre(), b.centre() });
+    }
+    nodes[(size_t) index].bounds = box;
+
+    if (count <= maxLeafItems)
+    {
+        nodes[(size_t) index].first = first;
+        nodes[(size_t) index].count = count;
+        for (int i = first; i < first + count; ++i)
+            itemLeaf[(size_t) order[(size_t) i]] = index;
+        return index;
+    }
+
+    // Split at the median centre along the longer side. Ties are broken by
+    // item index, so the same obstacles always give the same tree
+    bool splitX = centres.max.x - centres.min.x >= centres.max.y - centres.min.y;
+    auto begin = order.begin() + first;
+    auto middle = begin + count / 2;
+
+    std::nth_element (begin, middle, begin + count, [&] (int a, int b)
+    {
+        float ca = splitX ? bounds[(size_t) a].centre().x : bounds[(size_t) a].centre().y;
+        float cb = splitX ? bounds[(size_t) b].centre().x : bounds[(size_t) b].centre().y;
+        return ca < cb || (ca == cb && a < b);
+    });
+
+    int left = buildNode (index, first, count / 2);
+    int right = buildNode (index, first + count / 2, count - count / 2);
+    nodes[(size_t) index].left = left;
+    nodes[(size_t) index].right = right;
+    return index;
+}
+
+void ObstacleTree::remove (int item)
+{
+    if (! contains (item))
+        return;
+
+    int leaf = itemLeaf[(size_t) item];
+    itemLeaf[(size_t) item] = -1;
+
+    Node& node = nodes[(size_t) leaf];
+    for (int i = node.first; i < node.first + node.count; ++i)
+        if (order[(size_t) i] == item)
+            order[(size_t) i] = -1;
+
+    refit (leaf);
+}
+
+bool ObstacleTree::contains (int item) const
+{
+    return item >= 0 && item < (int) itemLeaf.size() && itemLeaf[(size_t) item] >= 0;
+}
+
+void ObstacleTree::refit (int node)
+{
+    // Walk up to the root, stopping early if a box didn't change
+    while (node >= 0)
+    {
+        Node& n = nodes[(size_t) node];
+        Bounds box = Bounds::empty();
+
+        if (n.left < 0)
+        {
+            for (int i = n.first; i < n.first + n.count; ++i)
+                if (order[(size_t) i] >= 0)
+                    box.expand (bounds[(size_t) order[(size_t) i]]);
+        }
+        else
+        {
+            box = nodes[(size_t) n.left].bounds;
+            box.expand (nodes[(size_t) n.right].bounds);
+        }
+
+        if (box == n.bounds)
+            return;
+
+        n.bounds = box;
+        node = n.parent;
+    }
+}
+
+template <typename Overlaps>
+void ObstacleTree::collect (Overlaps overlaps, std::vector<int>& result) const
+{
+    result.clear();
+
+    if (nodes.empty())
+        return;
+
+    stack.clear();
+    stack.push_back (0);
+
+    while (! stack.empty())
+    {
+        const Node& node = nodes[(size_t) stack.back()];
+        stack.pop_back();
+
+        if (node.bounds.isEmpty() || ! overlaps (node.bounds))
+            continue;
+
+        if (node.left >= 0)
+        {
+            stack.push_back (node.right);
+            stack.push_back (node.left);
+            continue;
+        }
+
+        for (int i = node.first; i < node.first + node.count; ++i)
+        {
+            int item = order[(size_t) i];
+            if (item >= 0 && overlaps (bounds[(size_t) item]))
+                result.push_back (item);
+        }
+    }
+
+    // Callers rely on the same order as a linear scan
+    std::sort (result.begin(), result.end());
+}
+
+void ObstacleTree::query (const Bounds& box, std::vector<int>& result) const
+{
+    collect ([&] (const Bounds& b) { return b.overlaps (box); }, result);
+}
+
+void ObstacleTree::querySegment (Vec2 start, Vec2 end, float radius, std::vector<int>& result) const
+{
+    Bounds path = Bounds::ofSegment (start, end, radius);
+    collect ([&] (const Bounds& b) { return b.overlaps (path) && b.grown (radius).intersectsSegment (start, end); }, result);
+}
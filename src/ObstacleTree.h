@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Geometry.h"
+#include <vector>
+
+// =============================================================================
+// ObstacleTree
+// Bounding volume hierarchy over obstacle bounds. Obstacles never move, so the
+// tree is built once when the set changes (a round starts, something is
+// placed) and afterwards only shrinks: removing a dead obstacle refits the
+// boxes above its leaf rather than rebuilding. Items are indices into
+// whatever list the bounds came from, and queries return them in ascending
+// order so callers see the same order as a linear scan.
+// =============================================================================
+
+class ObstacleTree
+{
+public:
+    // Build from scratch. Items with empty bounds are left out.
+    void build (const std::vector<Bounds>& itemBounds);
+    void clear();
+
+    // Take an item out and refit the boxes above it
+    void remove (int item);
+    bool contains (int item) const;
+
+    // Items whose bounds overlap the box
+    void query (const Bounds& box, std::vector<int>& result) const;
+
+    // Items whose bounds, grown by radius, the segment touches
+    void querySegment (Vec2 start, Vec2 end, float radius, std::vector<int>& result) const;
+
+private:
+    static constexpr int maxLeafItems = 4;
+
+    struct Node
+    {
+        Bounds bounds;
+        int parent = -1;
+        int left = -1;              // Children, -1 for a leaf
+        int right = -1;
+        int first = 0;              // Leaf items are order[first, first + count)
+        int count = 0;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> order;         // Items grouped by leaf, -1 once removed
+    std::vector<Bounds> bounds;     // Per item
+    std::vector<int> itemLeaf;      // Leaf holding each item, -1 if not in the tree
+    mutable std::vector<int> stack; // Scratch for traversal
+
+    int buildNode (int parent, int first, int count);
+    void refit (int node);
+
+    template <typename Overlaps>
+    void collect (Overlaps overlaps, std::vector<int>& result) const;
+};
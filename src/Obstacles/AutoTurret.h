@@ -1,10 +1,9 @@
 #pragma once
 
 #include "Obstacle.h"
-#include "../Renderer.h"
 #include "../Tank.h"
 
-class AutoTurret : public Obstacle
+class AutoTurret final : public Obstacle
 {
 public:
     AutoTurret (Vec2 position, float angle, int ownerIndex)
@@ -22,6 +21,9 @@ public:
     float getTurretAngle() const { return turretAngle; }
     float getReloadProgress() const { return reloadTimer / config.turretFireInterval; }
 
+    // Tanks the turret has a clear line to, a bit per player index. Set by the world each step
+    void setVisibleTargets (uint32_t mask) { visibleTargets = mask; }
+
     void update (float dt, const std::vector<Tank*>& tanks, float, float) override
     {
         if (!alive)
@@ -96,44 +98,15 @@ public:
         return checkCircleTankCollision (tank, 15.0f, pushDirection, pushDistance);
     }
 
-    bool isValidPlacement (const std::vector<std::unique_ptr<Obstacle>>& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const override
+    bool isValidPlacement (const ObstacleList& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const override
     {
         return isValidCirclePlacement (15.0f, obstacles, tanks, arenaWidth, arenaHeight);
     }
 
-    void draw (Renderer& renderer) const override
-    {
-        // Base
-        renderer.drawFilledCircle (position, 15.0f, config.colorAutoTurret);
-        renderer.drawCircle (position, 15.0f, config.colorBlack);
-
-        // Barrel
-        Vec2 barrelDir = Vec2::fromAngle (turretAngle);
-        Vec2 barrelEnd = position + barrelDir * 25.0f;
-        renderer.drawLineThick (position, barrelEnd, 4.0f, config.colorBarrel);
-
-        // Reload indicator
-        if (reloadTimer < config.turretFireInterval)
-        {
-            float progress = reloadTimer / config.turretFireInterval;
-            Color reloadColor = { 255, (unsigned char) (255 * progress), 0, 200 };
-            renderer.drawFilledCircle (position, 5.0f * progress, reloadColor);
-        }
-        else
-        {
-            renderer.drawFilledCircle (position, 5.0f, config.colorReloadReady);
-        }
-    }
-
-    void drawPreview (Renderer& renderer, bool valid) const override
-    {
-        Color color = valid ? config.colorPlacementValid : config.colorPlacementInvalid;
-        renderer.drawFilledCircle (position, 15.0f, color);
-    }
-
 private:
     float turretAngle = 0.0f;
     float reloadTimer = 0.0f;
+    uint32_t visibleTargets = ~0u;
 
     Tank* findNearestEnemy (const std::vector<Tank*>& tanks) const
     {
@@ -142,7 +115,7 @@ private:
 
         for (Tank* tank : tanks)
         {
-            if (!tank || !tank->isAlive())
+            if (!tank || !tank->isAlive() || !((visibleTargets >> tank->getPlayerIndex()) & 1))
                 continue;
 
             float dist = (tank->getPosition() - position).length();
@@ -1,26 +1,31 @@
 #pragma once
 
 #include "Obstacle.h"
-#include "../Renderer.h"
 #include "../Tank.h"
 #include "../Random.h"
 
-class Electromagnet : public Obstacle
+class Electromagnet final : public Obstacle
 {
 public:
     Electromagnet (Vec2 position, float angle, int ownerIndex)
         : Obstacle (position, angle, ownerIndex)
+    {
+        cycleDuration = config.electromagnetDutyCycle;
+    }
+
+    void onPlaced (Random& random) override
     {
         // Randomize cycle duration (+/- 30%) so magnets don't sync up
-        cycleDuration = config.electromagnetDutyCycle * (0.7f + randomFloat() * 0.6f);
+        cycleDuration = config.electromagnetDutyCycle * (0.7f + random.nextFloat() * 0.6f);
         // Start with random phase
-        cycleTimer = randomFloat() * cycleDuration;
+        cycleTimer = random.nextFloat() * cycleDuration;
     }
 
     ObstacleType getType() const override { return ObstacleType::Electromagnet; }
     float getCollisionRadius() const override { return config.electromagnetRadius; }
 
     bool isActive() const { return active; }
+    float getPulseProgress() const { return pulseTimer; }
     float getRange() const { return config.electromagnetRange; }
     float getForce() const { return config.electromagnetForce; }
 
@@ -47,9 +52,9 @@ public:
     }
 
     // Override base class force methods
-    Vec2 getTankForce (const Tank& tank) const override
+    Vec2 getTankForce (Vec2 tankPos) const override
     {
-        return calculatePullForceAtPosition (tank.getPosition(), config.electromagnetForce);
+        return calculatePullForceAtPosition (tankPos, config.electromagnetForce);
     }
 
     Vec2 getShellForce (Vec2 shellPos) const override
@@ -57,6 +62,8 @@ public:
         return calculatePullForceAtPosition (shellPos, config.electromagnetForce * 5.0f);
     }
 
+    bool isEmittingForce() const override { return alive && active; }
+
 private:
     Vec2 calculatePullForceAtPosition (Vec2 targetPos, float force) const
     {
@@ -90,67 +97,14 @@ public:
         return false;
     }
 
-    bool isValidPlacement (const std::vector<std::unique_ptr<Obstacle>>& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const override
+    bool isValidPlacement (const ObstacleList& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const override
     {
         return isValidCirclePlacement (config.electromagnetRadius, obstacles, tanks, arenaWidth, arenaHeight);
     }
 
-    void draw (Renderer& renderer) const override
-    {
-        if (!alive)
-            return;
-
-        Color baseColor = active ? config.colorElectromagnetOn : config.colorElectromagnetOff;
-
-        // Draw range indicator when active (faint)
-        if (active)
-        {
-            Color rangeColor = { baseColor.r, baseColor.g, baseColor.b, 30 };
-            renderer.drawCircle (position, config.electromagnetRange, rangeColor);
-
-            // Pulsing rings when active
-            float pulseRadius = config.electromagnetRadius + (config.electromagnetRange - config.electromagnetRadius) * pulseTimer;
-            Color pulseColor = { baseColor.r, baseColor.g, baseColor.b, (unsigned char) (100 * (1.0f - pulseTimer)) };
-            renderer.drawCircle (position, pulseRadius, pulseColor);
-        }
-
-        // Main body
-        renderer.drawFilledCircle (position, config.electromagnetRadius, baseColor);
-        renderer.drawCircle (position, config.electromagnetRadius, config.colorBlack);
-
-        // Inner core
-        Color coreColor = active ? config.colorWhite : config.colorGreyDark;
-        renderer.drawFilledCircle (position, config.electromagnetRadius * 0.4f, coreColor);
-
-        // Magnetic field lines (decorative)
-        if (active)
-        {
-            Color lineColor = { 255, 255, 255, 150 };
-            for (int i = 0; i < 4; ++i)
-            {
-                float a = angle + i * pi * 0.5f;
-                Vec2 inner = position + Vec2::fromAngle (a) * (config.electromagnetRadius * 0.5f);
-                Vec2 outer = position + Vec2::fromAngle (a) * config.electromagnetRadius;
-                renderer.drawLine (inner, outer, lineColor);
-            }
-        }
-    }
-
-    void drawPreview (Renderer& renderer, bool valid) const override
-    {
-        Color color = valid ? config.colorPlacementValid : config.colorPlacementInvalid;
-        renderer.drawFilledCircle (position, config.electromagnetRadius, color);
-
-        // Show range
-        Color rangeColor = { color.r, color.g, color.b, 50 };
-        renderer.drawCircle (position, config.electromagnetRange, rangeColor);
-    }
-
 private:
     bool active = true;
     float cycleTimer = 0.0f;
-    float cycleDuration = 10.0f;  // Randomized in constructor
+    float cycleDuration = 10.0f;  // Randomized in onPlaced
     float pulseTimer = 0.0f;
-
-    static constexpr float pi = 3.14159265358979323846f;
 };
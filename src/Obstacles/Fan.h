@@ -1,10 +1,9 @@
 #pragma once
 
 #include "Obstacle.h"
-#include "../Renderer.h"
 #include "../Tank.h"
 
-class Fan : public Obstacle
+class Fan final : public Obstacle
 {
 public:
     Fan (Vec2 position, float angle, int ownerIndex)
@@ -15,6 +14,7 @@ public:
 
     ObstacleType getType() const override { return ObstacleType::Fan; }
     float getCollisionRadius() const override { return config.fanRadius; }
+    float getBladeAngle() const { return bladeAngle; }
 
     void takeDamage (float) override
     {
@@ -33,9 +33,9 @@ public:
     }
 
     // Override base class force methods
-    Vec2 getTankForce (const Tank& tank) const override
+    Vec2 getTankForce (Vec2 tankPos) const override
     {
-        return calculatePushForceAtPosition (tank.getPosition(), config.fanForce);
+        return calculatePushForceAtPosition (tankPos, config.fanForce);
     }
 
     Vec2 getShellForce (Vec2 shellPos) const override
@@ -43,6 +43,8 @@ public:
         return calculatePushForceAtPosition (shellPos, config.fanForce * 3.0f);
     }
 
+    bool isEmittingForce() const override { return alive; }
+
 private:
     Vec2 calculatePushForceAtPosition (Vec2 targetPos, float force) const
     {
@@ -90,63 +92,11 @@ public:
         return false;
     }
 
-    bool isValidPlacement (const std::vector<std::unique_ptr<Obstacle>>& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const override
+    bool isValidPlacement (const ObstacleList& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const override
     {
         return isValidCirclePlacement (config.fanRadius, obstacles, tanks, arenaWidth, arenaHeight);
     }
 
-    void draw (Renderer& renderer) const override
-    {
-        if (!alive)
-            return;
-
-        Vec2 fanDir = Vec2::fromAngle (angle);
-
-        // Draw wind effect (faint lines in direction of blow)
-        Color windColor = { 200, 200, 255, 40 };
-        for (int i = 0; i < 5; ++i)
-        {
-            float offset = (float) i / 4.0f - 0.5f;
-            Vec2 perpDir = { -fanDir.y, fanDir.x };
-            Vec2 startPos = position + fanDir * config.fanRadius + perpDir * offset * 30.0f;
-            Vec2 endPos = startPos + fanDir * config.fanRange * 0.8f;
-            renderer.drawLine (startPos, endPos, windColor);
-        }
-
-        // Draw fan housing (circle)
-        renderer.drawFilledCircle (position, config.fanRadius, config.colorFan);
-        renderer.drawCircle (position, config.fanRadius, config.colorBlack);
-
-        // Draw spinning blades
-        for (int i = 0; i < 4; ++i)
-        {
-            float a = bladeAngle + i * pi * 0.5f;
-            Vec2 bladeEnd = position + Vec2::fromAngle (a) * (config.fanRadius * 0.8f);
-            renderer.drawLineThick (position, bladeEnd, 3.0f, config.colorFanBlade);
-        }
-
-        // Center hub
-        renderer.drawFilledCircle (position, config.fanRadius * 0.2f, config.colorFanBlade);
-
-        // Direction indicator
-        Vec2 arrowTip = position + fanDir * (config.fanRadius + 8.0f);
-        Vec2 arrowLeft = arrowTip - fanDir * 6.0f + Vec2 { -fanDir.y, fanDir.x } * 4.0f;
-        Vec2 arrowRight = arrowTip - fanDir * 6.0f - Vec2 { -fanDir.y, fanDir.x } * 4.0f;
-        renderer.drawLine (arrowTip, arrowLeft, config.colorBlack);
-        renderer.drawLine (arrowTip, arrowRight, config.colorBlack);
-    }
-
-    void drawPreview (Renderer& renderer, bool valid) const override
-    {
-        Color color = valid ? config.colorPlacementValid : config.colorPlacementInvalid;
-        renderer.drawFilledCircle (position, config.fanRadius, color);
-
-        // Show direction
-        Vec2 fanDir = Vec2::fromAngle (angle);
-        Vec2 arrowEnd = position + fanDir * (config.fanRadius + 15.0f);
-        renderer.drawLineThick (position, arrowEnd, 3.0f, color);
-    }
-
 private:
     float bladeAngle = 0.0f;
 
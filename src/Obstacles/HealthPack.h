@@ -1,10 +1,9 @@
 #pragma once
 
 #include "Obstacle.h"
-#include "../Renderer.h"
 #include "../Tank.h"
 
-class HealthPack : public Obstacle
+class HealthPack final : public Obstacle
 {
 public:
     HealthPack (Vec2 position, float angle, int ownerIndex)
@@ -14,6 +13,7 @@ public:
 
     ObstacleType getType() const override { return ObstacleType::HealthPack; }
     float getCollisionRadius() const override { return config.healthPackRadius; }
+    float getPulsePhase() const { return pulseTimer; }
 
     // Override base class collection effect
     CollectionEffect consumeCollectionEffect() override
@@ -64,51 +64,11 @@ public:
         return false;
     }
 
-    bool isValidPlacement (const std::vector<std::unique_ptr<Obstacle>>& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const override
+    bool isValidPlacement (const ObstacleList& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const override
     {
         return isValidCirclePlacement (config.healthPackRadius, obstacles, tanks, arenaWidth, arenaHeight);
     }
 
-    void draw (Renderer& renderer) const override
-    {
-        if (!alive)
-            return;
-
-        // Pulsing green color for health
-        float pulse = 0.8f + 0.2f * std::sin (pulseTimer);
-        Color color = { (unsigned char) (100 * pulse), (unsigned char) (220 * pulse), (unsigned char) (100 * pulse), 255 };
-
-        // Outer glow
-        Color glowColor = { color.r, color.g, color.b, 80 };
-        renderer.drawFilledCircle (position, config.healthPackRadius * 1.4f, glowColor);
-
-        // Main body
-        renderer.drawFilledCircle (position, config.healthPackRadius, color);
-        renderer.drawCircle (position, config.healthPackRadius, config.colorWhite);
-
-        // Draw cross/plus icon for health
-        Color iconColor = config.colorWhite;
-        float r = config.healthPackRadius * 0.5f;
-        float thickness = r * 0.4f;
-
-        // Horizontal bar
-        renderer.drawFilledRect ({ position.x - r, position.y - thickness / 2 }, r * 2, thickness, iconColor);
-        // Vertical bar
-        renderer.drawFilledRect ({ position.x - thickness / 2, position.y - r }, thickness, r * 2, iconColor);
-    }
-
-    void drawPreview (Renderer& renderer, bool valid) const override
-    {
-        Color color = valid ? config.colorPlacementValid : config.colorPlacementInvalid;
-        renderer.drawFilledCircle (position, config.healthPackRadius, color);
-
-        // Show cross icon
-        float r = config.healthPackRadius * 0.5f;
-        float thickness = r * 0.4f;
-        renderer.drawFilledRect ({ position.x - r, position.y - thickness / 2 }, r * 2, thickness, color);
-        renderer.drawFilledRect ({ position.x - thickness / 2, position.y - r }, thickness, r * 2, color);
-    }
-
 private:
     int collectedBy = -1;
     bool effectApplied = false;
@@ -1,9 +1,8 @@
 #pragma once
 
 #include "Obstacle.h"
-#include "../Renderer.h"
 
-class Mine : public Obstacle
+class Mine final : public Obstacle
 {
 public:
     Mine (Vec2 position, float angle, int ownerIndex)
@@ -17,6 +16,8 @@ public:
 
     bool isArmed() const override { return armTimer >= config.mineArmTime; }
     float getArmProgress() const { return std::min (1.0f, armTimer / config.mineArmTime); }
+    float getArmTime() const { return armTimer; }
+    bool isRevealed() const { return revealed; }
 
     void update (float dt, const std::vector<Tank*>&, float, float) override
     {
@@ -44,59 +45,11 @@ public:
         return false;
     }
 
-    bool isValidPlacement (const std::vector<std::unique_ptr<Obstacle>>& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const override
+    bool isValidPlacement (const ObstacleList& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const override
     {
         return isValidCirclePlacement (config.mineRadius, obstacles, tanks, arenaWidth, arenaHeight);
     }
 
-    void draw (Renderer& renderer) const override
-    {
-        float radius = config.mineRadius;
-        unsigned char alpha = revealed ? 255 : 13;  // 0.05 * 255 ≈ 13
-
-        Color color = isArmed() ? config.colorMineArmed : config.colorMine;
-        color.a = alpha;
-
-        renderer.drawFilledCircle (position, radius, color);
-
-        Color outlineColor = config.colorBlack;
-        outlineColor.a = alpha;
-        renderer.drawCircle (position, radius, outlineColor);
-
-        // Spikes
-        int spikes = 8;
-        for (int i = 0; i < spikes; ++i)
-        {
-            float spikeAngle = (2.0f * pi * i) / spikes;
-            Vec2 spikeEnd = position + Vec2::fromAngle (spikeAngle) * (radius * 1.3f);
-            renderer.drawLine (position + Vec2::fromAngle (spikeAngle) * radius, spikeEnd, outlineColor);
-        }
-
-        // Blinking light when armed
-        if (isArmed())
-        {
-            float blink = std::fmod (armTimer * 4.0f, 1.0f);
-            if (blink < 0.5f)
-            {
-                Color lightColor = { 255, 0, 0, alpha };
-                renderer.drawFilledCircle (position, radius * 0.2f, lightColor);
-            }
-        }
-        else
-        {
-            // Arming progress
-            float progress = getArmProgress();
-            Color progressColor = { 255, 200, 0, alpha };
-            renderer.drawFilledCircle (position, radius * 0.3f * progress, progressColor);
-        }
-    }
-
-    void drawPreview (Renderer& renderer, bool valid) const override
-    {
-        Color color = valid ? config.colorPlacementValid : config.colorPlacementInvalid;
-        renderer.drawFilledCircle (position, config.mineRadius, color);
-    }
-
 private:
     float armTimer = 0.0f;
     bool revealed = false;
@@ -1,6 +1,5 @@
 #include "Obstacle.h"
 #include "../Tank.h"
-#include "../Renderer.h"
 #include <algorithm>
 
 bool Obstacle::checkCircleTankCollision (const Tank& tank, float radius, Vec2& pushDirection, float& pushDistance) const
@@ -18,7 +17,7 @@ bool Obstacle::checkCircleTankCollision (const Tank& tank, float radius, Vec2& p
     return false;
 }
 
-bool Obstacle::isValidCirclePlacement (float radius, const std::vector<std::unique_ptr<Obstacle>>& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const
+bool Obstacle::isValidCirclePlacement (float radius, const ObstacleList& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const
 {
     float margin = 20.0f;
 
@@ -28,7 +27,7 @@ bool Obstacle::isValidCirclePlacement (float radius, const std::vector<std::uniq
 
     for (const auto& other : obstacles)
     {
-        if (other.get() == this)
+        if (other == this)
             continue;
 
         Vec2 diff = position - other->getPosition();
@@ -58,72 +57,82 @@ bool Wall::checkTankCollision (const Tank& tank, Vec2& pushDirection, float& pus
     if (!alive)
         return false;
 
-    auto wallCorners = getCorners();
-    auto tankCorners = tank.getCorners();
-
-    float minOverlap = 999999.0f;
     Vec2 minAxis;
-    bool separated = false;
+    float minOverlap;
+    if (QuadTests::overlap (getBox(), tank.getHull(), minAxis, minOverlap))
+    {
+        Vec2 toTank = tank.getPosition() - position;
+        if (toTank.dot (minAxis) < 0)
+            minAxis = minAxis * -1.0f;
+
+        pushDirection = minAxis;
+        pushDistance = minOverlap / 2.0f + 1.0f;
+        return true;
+    }
 
-    Vec2 axes[4] = {
-        (wallCorners[1] - wallCorners[0]).normalized(),
-        (wallCorners[3] - wallCorners[0]).normalized(),
-        (tankCorners[1] - tankCorners[0]).normalized(),
-        (tankCorners[3] - tankCorners[0]).normalized()
-    };
+    return false;
+}
 
-    for (int a = 0; a < 4 && !separated; ++a)
-    {
-        Vec2 axis = axes[a];
-        Vec2 perpAxis = { -axis.y, axis.x };
+bool Wall::raycast (Vec2 start, Vec2 end, float& fraction, Vec2& normal) const
+{
+    // Slab test in the wall's own frame, x along its length and y across it
+    const OrientedBox& wallBox = getBox();
+    Vec2 axes[2] = { wallBox.getAxisX(), wallBox.getAxisY() };
+    float halfSize[2] = { wallBox.halfSize.x, wallBox.halfSize.y };
 
-        float minA = 999999.0f, maxA = -999999.0f;
-        float minB = 999999.0f, maxB = -999999.0f;
+    Vec2 relative = start - position;
+    Vec2 delta = end - start;
 
-        for (int c = 0; c < 4; ++c)
+    float enter = 0.0f;
+    float leave = 1.0f;
+    int enterAxis = -1;
+    float enterSide = 0.0f;
+
+    for (int a = 0; a < 2; ++a)
+    {
+        float origin = relative.dot (axes[a]);
+        float direction = delta.dot (axes[a]);
+
+        // Parallel to this pair of faces, so either always between them or never
+        if (std::abs (direction) < 1e-8f)
         {
-            float projA = wallCorners[c].dot (perpAxis);
-            float projB = tankCorners[c].dot (perpAxis);
-            minA = std::min (minA, projA);
-            maxA = std::max (maxA, projA);
-            minB = std::min (minB, projB);
-            maxB = std::max (maxB, projB);
+            if (origin < -halfSize[a] || origin > halfSize[a])
+                return false;
+            continue;
         }
 
-        if (maxA < minB || maxB < minA)
+        float slabEnter = (-halfSize[a] - origin) / direction;
+        float slabExit = (halfSize[a] - origin) / direction;
+        float side = -1.0f;
+
+        if (slabEnter > slabExit)
         {
-            separated = true;
+            std::swap (slabEnter, slabExit);
+            side = 1.0f;
         }
-        else
+
+        if (slabEnter > enter)
         {
-            float overlap = std::min (maxA - minB, maxB - minA);
-            if (overlap < minOverlap)
-            {
-                minOverlap = overlap;
-                minAxis = perpAxis;
-            }
+            enter = slabEnter;
+            enterAxis = a;
+            enterSide = side;
         }
-    }
 
-    if (!separated)
-    {
-        Vec2 toTank = tank.getPosition() - position;
-        if (toTank.dot (minAxis) < 0)
-            minAxis = minAxis * -1.0f;
-
-        pushDirection = minAxis;
-        pushDistance = minOverlap / 2.0f + 1.0f;
-        return true;
+        leave = std::min (leave, slabExit);
+        if (enter > leave)
+            return false;
     }
 
-    return false;
+    fraction = enter;
+    normal = enterAxis < 0 ? delta.normalized() * -1.0f : axes[enterAxis] * enterSide;
+    return true;
 }
 
-bool Wall::checkCommonPlacement (const std::vector<std::unique_ptr<Obstacle>>& obstacles, const std::vector<Tank*>& tanks) const
+bool Wall::checkCommonPlacement (const ObstacleList& obstacles, const std::vector<Tank*>& tanks) const
 {
     for (const auto& other : obstacles)
     {
-        if (other.get() == this)
+        if (other == this)
             continue;
 
         Vec2 diff = position - other->getPosition();
@@ -147,9 +156,3 @@ bool Wall::checkCommonPlacement (const std::vector<std::unique_ptr<Obstacle>>& o
 
     return true;
 }
-
-void Wall::drawWallPreview (Renderer& renderer, bool valid) const
-{
-    Color color = valid ? config.colorPlacementValid : config.colorPlacementInvalid;
-    renderer.drawFilledRotatedRect (position, config.wallLength, config.wallThickness, angle, color);
-}
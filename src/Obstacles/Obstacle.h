@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../Config.h"
+#include "../Geometry.h"
+#include "../QuadTests.h"
 #include "../Shell.h"
 #include "../Vec2.h"
 #include <raylib.h>
@@ -9,8 +11,8 @@
 #include <memory>
 #include <vector>
 
+class Random;
 class Tank;
-class Renderer;
 
 enum class ObstacleType
 {
@@ -37,6 +39,11 @@ enum class ShellHitResult
     Ricochet  // Splits into multiple shells
 };
 
+class Obstacle;
+
+// Non-owning list of obstacles in placement order
+using ObstacleList = std::vector<Obstacle*>;
+
 class Obstacle
 {
 public:
@@ -50,8 +57,9 @@ public:
     virtual ObstacleType getType() const = 0;
 
     // Force application - override in Electromagnet, Fan
-    virtual Vec2 getTankForce (const Tank& tank) const { return { 0, 0 }; }
+    virtual Vec2 getTankForce (Vec2 tankPos) const { return { 0, 0 }; }
     virtual Vec2 getShellForce (Vec2 shellPos) const { return { 0, 0 }; }
+    virtual bool isEmittingForce() const { return false; }  // Whether the forces above can be non-zero right now
 
     // Collection effects (flag capture, health pack pickup)
     struct CollectionEffect
@@ -64,13 +72,19 @@ public:
 
     // Tank collision handling - called when checkTankCollision returns true
     // Return true to apply normal physics push, false to skip it
-    virtual bool handleTankCollision (Tank& tank, const std::vector<std::unique_ptr<Obstacle>>& allObstacles) { return true; }
+    virtual bool handleTankCollision (Tank& tank, const ObstacleList& allObstacles, Random& random) { return true; }
+
+    // Called once when the obstacle is committed to the arena (not for previews)
+    virtual void onPlaced (Random& random) {}
 
     // Whether this obstacle creates an explosion when hit by shell (AutoTurret)
     virtual bool createsExplosionOnHit() const { return false; }
     virtual float getCollisionRadius() const { return 20.0f; }
     virtual bool isRectangular() const { return false; }
 
+    // Box around everything the collision checks can touch, for broadphase culling
+    virtual Bounds getBounds() const { return Bounds::around (position, getCollisionRadius()); }
+
     Vec2 getPosition() const { return position; }
     float getAngle() const { return angle; }
     int getOwnerIndex() const { return ownerIndex; }
@@ -92,10 +106,7 @@ public:
 
     virtual ShellHitResult checkShellCollision (const Shell& shell, Vec2& collisionPoint, Vec2& normal) const = 0;
     virtual bool checkTankCollision (const Tank& tank, Vec2& pushDirection, float& pushDistance) = 0;
-    virtual bool isValidPlacement (const std::vector<std::unique_ptr<Obstacle>>& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const = 0;
-
-    virtual void draw (Renderer& renderer) const = 0;
-    virtual void drawPreview (Renderer& renderer, bool valid) const = 0;
+    virtual bool isValidPlacement (const ObstacleList& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const = 0;
 
     std::vector<Shell>& getPendingShells() { return pendingShells; }
 
@@ -108,41 +119,45 @@ protected:
     std::vector<Shell> pendingShells;
 
     // Shared collision helpers
+
+    // Sweeps the shell along its path this step rather than testing where it ended
+    // up, so a fast shell can't skip over the circle between steps. The collision
+    // point is where the shell's centre was when it first touched
     bool checkCircleCollision (const Shell& shell, float radius, Vec2& collisionPoint, Vec2& normal) const
     {
-        Vec2 diff = shell.getPosition() - position;
-        float dist = diff.length();
+        Vec2 start = shell.getPreviousPosition();
+        Vec2 path = shell.getPosition() - start;
+        Vec2 fromCentre = start - position;
+        float reach = radius + shell.getRadius();
 
-        if (dist < radius + shell.getRadius())
+        // |fromCentre + path * t| = reach, for the first t in [0, 1]
+        float c = fromCentre.lengthSquared() - reach * reach;
+        float t = 0.0f;
+
+        if (c > 0.0f)
         {
-            collisionPoint = shell.getPosition();
-            normal = diff.normalized();
-            return true;
+            float a = path.lengthSquared();
+            float b = fromCentre.dot (path);
+            if (a <= 0.0f || b >= 0.0f)
+                return false;   // Outside and not heading in
+
+            float discriminant = b * b - a * c;
+            if (discriminant < 0.0f)
+                return false;
+
+            t = (-b - std::sqrt (discriminant)) / a;
+            if (t > 1.0f)
+                return false;
         }
-        return false;
+
+        collisionPoint = start + path * t;
+        normal = (collisionPoint - position).normalized();
+        return true;
     }
 
     bool checkCircleTankCollision (const Tank& tank, float radius, Vec2& pushDirection, float& pushDistance) const;
 
-    bool isValidCirclePlacement (float radius, const std::vector<std::unique_ptr<Obstacle>>& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const;
-
-    static bool lineSegmentIntersection (Vec2 p1, Vec2 p2, Vec2 p3, Vec2 p4, Vec2& intersection)
-    {
-        float d1 = (p4.x - p3.x) * (p1.y - p3.y) - (p4.y - p3.y) * (p1.x - p3.x);
-        float d2 = (p4.x - p3.x) * (p2.y - p3.y) - (p4.y - p3.y) * (p2.x - p3.x);
-        float d3 = (p2.x - p1.x) * (p3.y - p1.y) - (p2.y - p1.y) * (p3.x - p1.x);
-        float d4 = (p2.x - p1.x) * (p4.y - p1.y) - (p2.y - p1.y) * (p4.x - p1.x);
-
-        if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) &&
-            ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0)))
-        {
-            float t = d1 / (d1 - d2);
-            intersection.x = p1.x + t * (p2.x - p1.x);
-            intersection.y = p1.y + t * (p2.y - p1.y);
-            return true;
-        }
-        return false;
-    }
+    bool isValidCirclePlacement (float radius, const ObstacleList& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const;
 };
 
 // Wall base class for rectangular obstacles
@@ -150,43 +165,37 @@ class Wall : public Obstacle
 {
 public:
     Wall (Vec2 position, float angle, int ownerIndex)
-        : Obstacle (position, angle, ownerIndex) {}
+        : Obstacle (position, angle, ownerIndex)
+    {
+        updateBox();
+    }
 
     bool isRectangular() const override { return true; }
+    Bounds getBounds() const override { return getBox().bounds; }
 
     float getLength() const { return config.wallLength; }
     float getThickness() const { return config.wallThickness; }
 
-    std::array<Vec2, 4> getCorners() const
+    // Walls never move, so the box is only worked out again if the config changes the wall size
+    const OrientedBox& getBox() const
     {
-        float halfLength = config.wallLength / 2.0f;
-        float halfThickness = config.wallThickness / 2.0f;
-
-        float cosA = std::cos (angle);
-        float sinA = std::sin (angle);
-
-        Vec2 localCorners[4] = {
-            { -halfLength, -halfThickness },
-            { halfLength, -halfThickness },
-            { halfLength, halfThickness },
-            { -halfLength, halfThickness }
-        };
-
-        std::array<Vec2, 4> worldCorners;
-        for (int i = 0; i < 4; ++i)
-        {
-            worldCorners[i].x = position.x + localCorners[i].x * cosA - localCorners[i].y * sinA;
-            worldCorners[i].y = position.y + localCorners[i].x * sinA + localCorners[i].y * cosA;
-        }
-        return worldCorners;
+        if (boxGeneration != config.getGeneration())
+            updateBox();
+        return box;
     }
 
+    const std::array<Vec2, 4>& getCorners() const { return getBox().corners; }
+
     bool checkTankCollision (const Tank& tank, Vec2& pushDirection, float& pushDistance) override;
 
-    bool isValidPlacement (const std::vector<std::unique_ptr<Obstacle>>& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const override
+    // Where the segment first enters the wall, as a fraction of the way from start to end,
+    // and the normal of the face it comes through. A start inside the wall hits at 0
+    bool raycast (Vec2 start, Vec2 end, float& fraction, Vec2& normal) const;
+
+    bool isValidPlacement (const ObstacleList& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const override
     {
         float margin = 20.0f;
-        auto corners = getCorners();
+        const auto& corners = getCorners();
         for (const auto& corner : corners)
         {
             if (corner.x < margin || corner.x > arenaWidth - margin ||
@@ -199,49 +208,25 @@ public:
 protected:
     bool checkWallShellCollision (const Shell& shell, Vec2& collisionPoint, Vec2& normal) const
     {
-        auto corners = getCorners();
-        Vec2 shellPrev = shell.getPreviousPosition();
-        Vec2 shellCur = shell.getPosition();
+        const auto& corners = getCorners();
 
-        for (int i = 0; i < 4; ++i)
+        // A shell can cross two edges in one step, the one it reaches first is the hit
+        int hitEdge;
+        if (QuadTests::firstEdgeCrossing (shell.getPreviousPosition(), shell.getPosition(), corners, hitEdge, collisionPoint))
         {
-            Vec2 p1 = corners[i];
-            Vec2 p2 = corners[(i + 1) % 4];
-
-            Vec2 intersection;
-            if (lineSegmentIntersection (shellPrev, shellCur, p1, p2, intersection))
-            {
-                collisionPoint = intersection;
-                Vec2 edge = p2 - p1;
-                normal = Vec2 { -edge.y, edge.x }.normalized();
+            Vec2 edge = corners[(hitEdge + 1) % 4] - corners[hitEdge];
+            normal = Vec2 { -edge.y, edge.x }.normalized();
 
-                if ((collisionPoint - position).dot (normal) < 0)
-                    normal = normal * -1.0f;
+            if ((collisionPoint - position).dot (normal) < 0)
+                normal = normal * -1.0f;
 
-                return true;
-            }
+            return true;
         }
 
         // Check if shell is inside wall
-        Vec2 shellPos = shell.getPosition();
-        bool inside = true;
-        for (int i = 0; i < 4; ++i)
-        {
-            Vec2 p1 = corners[i];
-            Vec2 p2 = corners[(i + 1) % 4];
-            Vec2 edge = p2 - p1;
-            Vec2 toPoint = shellPos - p1;
-
-            if (edge.x * toPoint.y - edge.y * toPoint.x < 0)
-            {
-                inside = false;
-                break;
-            }
-        }
-
-        if (inside)
+        if (QuadTests::contains (corners, shell.getPosition()))
         {
-            collisionPoint = shellPos;
+            collisionPoint = shell.getPosition();
             normal = shell.getVelocity().normalized() * -1.0f;
             return true;
         }
@@ -249,7 +234,17 @@ protected:
         return false;
     }
 
-    bool checkCommonPlacement (const std::vector<std::unique_ptr<Obstacle>>& obstacles, const std::vector<Tank*>& tanks) const;
+    bool checkCommonPlacement (const ObstacleList& obstacles, const std::vector<Tank*>& tanks) const;
+
+private:
+    mutable OrientedBox box;
+    mutable int boxGeneration = -1;
 
-    void drawWallPreview (Renderer& renderer, bool valid) const;
+    void updateBox() const
+    {
+        box.halfSize = { config.wallLength / 2.0f, config.wallThickness / 2.0f };
+        box.setAngle (angle);
+        box.moveTo (position);
+        boxGeneration = config.getGeneration();
+    }
 };
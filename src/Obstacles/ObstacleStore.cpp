@@ -0,0 +1,73 @@
+#include "ObstacleStore.h"
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+Obstacle& ObstacleStore::add (ObstacleType type, Vec2 position, float angle, int ownerIndex)
+{
+    Obstacle* obstacle = nullptr;
+
+    switch (type)
+    {
+        case ObstacleType::SolidWall:      obstacle = &emplace<SolidWall> (position, angle, ownerIndex); break;
+        case ObstacleType::BreakableWall:  obstacle = &emplace<BreakableWall> (position, angle, ownerIndex); break;
+        case ObstacleType::ReflectiveWall: obstacle = &emplace<ReflectiveWall> (position, angle, ownerIndex); break;
+        case ObstacleType::RicochetWall:   obstacle = &emplace<RicochetWall> (position, angle, ownerIndex); break;
+        case ObstacleType::Mine:           obstacle = &emplace<Mine> (position, angle, ownerIndex); break;
+        case ObstacleType::AutoTurret:     obstacle = &emplace<AutoTurret> (position, angle, ownerIndex); break;
+        case ObstacleType::Pit:            obstacle = &emplace<Pit> (position, angle, ownerIndex); break;
+        case ObstacleType::Portal:         obstacle = &emplace<Portal> (position, angle, ownerIndex); break;
+        case ObstacleType::Flag:           obstacle = &emplace<Flag> (position, angle, ownerIndex); break;
+        case ObstacleType::HealthPack:     obstacle = &emplace<HealthPack> (position, angle, ownerIndex); break;
+        case ObstacleType::Electromagnet:  obstacle = &emplace<Electromagnet> (position, angle, ownerIndex); break;
+        case ObstacleType::Fan:            obstacle = &emplace<Fan> (position, angle, ownerIndex); break;
+    }
+
+    all.push_back (obstacle);
+    types.push_back (type);
+    return *obstacle;
+}
+
+void ObstacleStore::clear()
+{
+    forEachBucket ([] (auto& bucket) { bucket.clear(); });
+    all.clear();
+    types.clear();
+}
+
+void ObstacleStore::removeDead()
+{
+    // Erasing shifts obstacles within their bucket, so note each survivor's place
+    // in the overall order first and rebuild the list from the buckets afterwards
+    std::unordered_map<const Obstacle*, size_t> order;
+    for (size_t i = 0; i < all.size(); ++i)
+        order[all[i]] = i;
+
+    std::vector<std::pair<size_t, Obstacle*>> survivors;
+
+    forEachBucket ([&] (auto& bucket)
+    {
+        std::vector<size_t> bucketOrder;
+        for (const auto& obstacle : bucket)
+            if (obstacle.isAlive())
+                bucketOrder.push_back (order[&obstacle]);
+
+        std::erase_if (bucket, [] (const auto& obstacle) { return ! obstacle.isAlive(); });
+
+        for (size_t i = 0; i < bucket.size(); ++i)
+            survivors.push_back ({ bucketOrder[i], &bucket[i] });
+    });
+
+    std::sort (survivors.begin(), survivors.end(),
+               [] (const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<ObstacleType> oldTypes;
+    oldTypes.swap (types);
+    all.clear();
+
+    for (const auto& [index, obstacle] : survivors)
+    {
+        all.push_back (obstacle);
+        types.push_back (oldTypes[index]);
+    }
+}
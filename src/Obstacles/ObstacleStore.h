@@ -0,0 +1,74 @@
+#pragma once
+
+#include "AllObstacles.h"
+#include <deque>
+#include <tuple>
+
+// =============================================================================
+// ObstacleStore
+// Owns the arena's obstacles in one contiguous bucket per type, so per-step
+// passes can loop over a single concrete type with no virtual dispatch and
+// skip types that have nothing to do. getAll() still lists every obstacle in
+// placement order for code that doesn't care about type.
+//
+// Buckets are deques: adding never moves existing obstacles, so pointers stay
+// valid until clear() or removeDead().
+// =============================================================================
+
+class ObstacleStore
+{
+public:
+    Obstacle& add (ObstacleType type, Vec2 position, float angle, int ownerIndex);
+    void clear();
+    void removeDead();
+
+    const ObstacleList& getAll() const { return all; }
+    size_t size() const { return all.size(); }
+    bool empty() const { return all.empty(); }
+
+    Obstacle& operator[] (size_t index) const { return *all[index]; }
+    ObstacleType getType (size_t index) const { return types[index]; }
+
+    template <typename T>
+    std::deque<T>& getBucket() { return std::get<std::deque<T>> (buckets); }
+
+    // Call fn with the obstacle as its concrete type, so the calls it makes bind statically
+    template <typename Fn>
+    static decltype (auto) visit (ObstacleType type, Obstacle& obstacle, Fn&& fn)
+    {
+        switch (type)
+        {
+            case ObstacleType::SolidWall:      return fn (static_cast<SolidWall&> (obstacle));
+            case ObstacleType::BreakableWall:  return fn (static_cast<BreakableWall&> (obstacle));
+            case ObstacleType::ReflectiveWall: return fn (static_cast<ReflectiveWall&> (obstacle));
+            case ObstacleType::RicochetWall:   return fn (static_cast<RicochetWall&> (obstacle));
+            case ObstacleType::Mine:           return fn (static_cast<Mine&> (obstacle));
+            case ObstacleType::AutoTurret:     return fn (static_cast<AutoTurret&> (obstacle));
+            case ObstacleType::Pit:            return fn (static_cast<Pit&> (obstacle));
+            case ObstacleType::Portal:         return fn (static_cast<Portal&> (obstacle));
+            case ObstacleType::Flag:           return fn (static_cast<Flag&> (obstacle));
+            case ObstacleType::HealthPack:     return fn (static_cast<HealthPack&> (obstacle));
+            case ObstacleType::Electromagnet:  return fn (static_cast<Electromagnet&> (obstacle));
+            case ObstacleType::Fan:            break;
+        }
+        return fn (static_cast<Fan&> (obstacle));
+    }
+
+private:
+    std::tuple<std::deque<SolidWall>, std::deque<BreakableWall>, std::deque<ReflectiveWall>,
+               std::deque<RicochetWall>, std::deque<Mine>, std::deque<AutoTurret>, std::deque<Pit>,
+               std::deque<Portal>, std::deque<Flag>, std::deque<HealthPack>, std::deque<Electromagnet>,
+               std::deque<Fan>> buckets;
+
+    ObstacleList all;                   // Placement order
+    std::vector<ObstacleType> types;    // Parallel to all
+
+    template <typename T>
+    T& emplace (Vec2 position, float angle, int ownerIndex) { return getBucket<T>().emplace_back (position, angle, ownerIndex); }
+
+    template <typename Fn>
+    void forEachBucket (Fn&& fn)
+    {
+        std::apply ([&fn] (auto&... bucket) { (fn (bucket), ...); }, buckets);
+    }
+};
@@ -1,9 +1,9 @@
 #pragma once
 
 #include "Obstacle.h"
-#include "../Renderer.h"
+#include "../Tank.h"
 
-class Pit : public Obstacle
+class Pit final : public Obstacle
 {
 public:
     Pit (Vec2 position, float angle, int ownerIndex)
@@ -14,6 +14,7 @@ public:
 
     ObstacleType getType() const override { return ObstacleType::Pit; }
     float getCollisionRadius() const override { return config.pitRadius; }
+    bool isRevealed() const { return revealed; }
 
     void takeDamage (float) override
     {
@@ -44,46 +45,18 @@ public:
         return false;
     }
 
-    bool handleTankCollision (Tank& tank, const std::vector<std::unique_ptr<Obstacle>>&) override
+    bool handleTankCollision (Tank& tank, const ObstacleList&, Random&) override
     {
         if (tank.canUseTeleporter())
             tank.trapInPit (config.pitTrapDuration);
         return false;  // No physics push
     }
 
-    bool isValidPlacement (const std::vector<std::unique_ptr<Obstacle>>& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const override
+    bool isValidPlacement (const ObstacleList& obstacles, const std::vector<Tank*>& tanks, float arenaWidth, float arenaHeight) const override
     {
         return isValidCirclePlacement (config.pitRadius, obstacles, tanks, arenaWidth, arenaHeight);
     }
 
-    void draw (Renderer& renderer) const override
-    {
-        unsigned char alpha = revealed ? 255 : 13;  // 0.05 * 255 ≈ 13
-
-        // Dark pit with concentric rings for depth effect
-        Color pitColor = config.colorPit;
-        pitColor.a = alpha;
-        renderer.drawFilledCircle (position, config.pitRadius, pitColor);
-
-        // Inner darker ring
-        Color innerColor = { 20, 15, 10, alpha };
-        renderer.drawFilledCircle (position, config.pitRadius * 0.7f, innerColor);
-
-        // Center darkest
-        Color centerColor = { 10, 5, 0, alpha };
-        renderer.drawFilledCircle (position, config.pitRadius * 0.4f, centerColor);
-
-        // Outline
-        Color outlineColor = { 60, 50, 40, alpha };
-        renderer.drawCircle (position, config.pitRadius, outlineColor);
-    }
-
-    void drawPreview (Renderer& renderer, bool valid) const override
-    {
-        Color color = valid ? config.colorPlacementValid : config.colorPlacementInvalid;
-        renderer.drawFilledCircle (position, config.pitRadius, color);
-    }
-
 private:
     bool revealed = false;
 };
@@ -1,9 +1,8 @@
 #pragma once
 
 #include "Obstacle.h"
-#include "../Renderer.h"
 
-class ReflectiveWall : public Wall
+class ReflectiveWall final : public Wall
 {
 public:
     ReflectiveWall (Vec2 position, float angle, int ownerIndex)
@@ -34,22 +33,4 @@ public:
 
         return ShellHitResult::Miss;
     }
-
-    void draw (Renderer& renderer) const override
-    {
-        renderer.drawFilledRotatedRect (position, config.wallLength, config.wallThickness, angle, config.colorReflectiveWall);
-
-        // Shiny highlight
-        Color highlight = { 220, 220, 255, 100 };
-        float cosA = std::cos (angle);
-        float sinA = std::sin (angle);
-        Vec2 highlightStart = { position.x - config.wallLength * 0.4f * cosA, position.y - config.wallLength * 0.4f * sinA };
-        Vec2 highlightEnd = { position.x + config.wallLength * 0.4f * cosA, position.y + config.wallLength * 0.4f * sinA };
-        renderer.drawLineThick (highlightStart, highlightEnd, 2.0f, highlight);
-    }
-
-    void drawPreview (Renderer& renderer, bool valid) const override
-    {
-        drawWallPreview (renderer, valid);
-    }
 };
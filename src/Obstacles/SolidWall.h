@@ -1,9 +1,8 @@
 #pragma once
 
 #include "Obstacle.h"
-#include "../Renderer.h"
 
-class SolidWall : public Wall
+class SolidWall final : public Wall
 {
 public:
     SolidWall (Vec2 position, float angle, int ownerIndex)
@@ -29,16 +28,4 @@ public:
 
         return ShellHitResult::Miss;
     }
-
-    void draw (Renderer& renderer) const override
-    {
-        renderer.drawFilledRotatedRect (position, config.wallLength, config.wallThickness, angle, config.colorSolidWall);
-        Color outline = { 60, 60, 60, 255 };
-        renderer.drawRotatedRect (position, config.wallLength, config.wallThickness, angle, outline);
-    }
-
-    void drawPreview (Renderer& renderer, bool valid) const override
-    {
-        drawWallPreview (renderer, valid);
-    }
 };
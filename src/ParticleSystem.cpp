@@ -0,0 +1,77 @@
+#include "ParticleSystem.h"
+#include "Config.h"
+#include <algorithm>
+
+namespace
+{
+    // Drop every element the predicate accepts, filling each hole from the back
+    template <typename T, typename Pred>
+    void swapRemoveIf (std::vector<T>& items, Pred shouldRemove)
+    {
+        size_t count = items.size();
+        size_t i = 0;
+
+        while (i < count)
+        {
+            if (! shouldRemove (items[i]))
+            {
+                i++;
+                continue;
+            }
+
+            count--;
+            if (i != count)
+                items[i] = items[count];
+        }
+
+        items.resize (count);
+    }
+}
+
+ParticleSystem::ParticleSystem()
+{
+    smoke.reserve ((size_t) std::max (0, config.particleBudget));
+    explosions.reserve (64);
+}
+
+void ParticleSystem::clear()
+{
+    smoke.clear();
+    explosions.clear();
+    trackMarkCount = 0;
+    time = 0.0f;
+    clearCount++;
+}
+
+void ParticleSystem::update (float dt)
+{
+    time += dt;
+
+    for (auto& s : smoke)
+        s.alpha -= s.fadeRate * dt;
+    swapRemoveIf (smoke, [] (const Smoke& s) { return s.alpha <= 0.0f; });
+
+    for (auto& explosion : explosions)
+        explosion.timer += dt;
+    swapRemoveIf (explosions, [] (const Explosion& e) { return ! e.isAlive(); });
+}
+
+void ParticleSystem::emitSmoke (const Smoke& s)
+{
+    if (smoke.size() < (size_t) std::max (0, config.particleBudget))
+        smoke.push_back (s);
+}
+
+void ParticleSystem::emitTrackMark (const TrackMark& mark)
+{
+    trackMarks[trackMarkCount++ % TRACK_MARK_HISTORY] = mark;
+}
+
+void ParticleSystem::emitExplosion (Vec2 position, float duration, float maxRadius)
+{
+    Explosion explosion;
+    explosion.position = position;
+    explosion.duration = duration;
+    explosion.maxRadius = maxRadius;
+    explosions.push_back (explosion);
+}
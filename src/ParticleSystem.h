@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Vec2.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+struct Smoke
+{
+    Vec2 position;
+    float radius;
+    float alpha;
+    float fadeRate;
+};
+
+struct TrackMark
+{
+    Vec2 position;
+    float angle;
+    float tankSize;
+};
+
+// How sparsely effects are emitted, lowered by the game when frames run long.
+// Only the spacing between emissions changes, gameplay is never affected
+struct EffectDensity
+{
+    float smokeIntervalScale = 1.0f;
+    float trackMarkSpacingScale = 1.0f;
+};
+
+struct Explosion
+{
+    Vec2 position;
+    float timer = 0.0f;
+    float duration = 0.0f;
+    float maxRadius = 0.0f;
+
+    float getProgress() const { return timer / duration; }
+    bool isAlive() const { return timer < duration; }
+};
+
+// =============================================================================
+// ParticleSystem
+// Every visual effect in the arena - smoke, track marks and explosions.
+// Smoke and explosions are pooled per type, updated and drawn a pool at a
+// time, and swap-removed as they fade, so order within a pool isn't kept.
+// Smoke is capped at config.particleBudget; once it's reached new puffs are
+// dropped until old ones fade. Explosions always spawn, there are never more
+// than a handful.
+//
+// Track marks don't fade here. The renderer stamps each one into a decal
+// layer once and fades the whole layer, so only the most recent marks are
+// kept, numbered in emission order, for it to pick up.
+// =============================================================================
+
+class ParticleSystem
+{
+public:
+    static constexpr size_t TRACK_MARK_HISTORY = 1024;
+
+    ParticleSystem();
+
+    void clear();
+    void update (float dt);
+
+    void emitSmoke (const Smoke& smoke);
+    void emitTrackMark (const TrackMark& mark);
+    void emitExplosion (Vec2 position, float duration, float maxRadius);
+
+    void setDensity (const EffectDensity& d)    { density = d; }
+    const EffectDensity& getDensity() const     { return density; }
+
+    const std::vector<Smoke>& getSmoke() const              { return smoke; }
+    const std::vector<Explosion>& getExplosions() const     { return explosions; }
+
+    // Marks are numbered from 0 since the last clear(), only the last TRACK_MARK_HISTORY are kept
+    uint64_t getTrackMarkCount() const                      { return trackMarkCount; }
+    const TrackMark& getTrackMark (uint64_t number) const   { return trackMarks[number % TRACK_MARK_HISTORY]; }
+
+    float getTime() const           { return time; }            // Simulated seconds since the last clear()
+    uint32_t getClearCount() const  { return clearCount; }      // Changes whenever everything is wiped
+
+private:
+    std::vector<Smoke> smoke;
+    std::vector<Explosion> explosions;
+
+    std::array<TrackMark, TRACK_MARK_HISTORY> trackMarks = {};
+    uint64_t trackMarkCount = 0;
+
+    EffectDensity density;
+
+    float time = 0.0f;
+    uint32_t clearCount = 0;
+};
@@ -109,4 +109,18 @@ std::string getUserDataDirectory()
     return fullPath;
 }
 
+std::string getUserDataSubdirectory (const std::string& name)
+{
+    std::string base = getUserDataDirectory();
+    if (base.empty())
+        return "";
+
+    std::string fullPath = base + "/" + name;
+
+    if (! createDirectoryRecursive (fullPath))
+        return "";
+
+    return fullPath;
+}
+
 }
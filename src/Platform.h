@@ -9,4 +9,7 @@ namespace Platform
     // Windows: %APPDATA%/Cambrai/
     // Linux: ~/.local/share/Cambrai/
     std::string getUserDataDirectory();
+
+    // Returns a named subdirectory of the user data directory, creating it if it doesn't exist.
+    std::string getUserDataSubdirectory (const std::string& name);
 }
@@ -25,11 +25,13 @@ void Player::update()
     if (gamepadId < 0 && playerIndex == 0)
     {
         usingKeyboard = true;
+        connected = true;
         updateKeyboardMouse();
         return;
     }
 
     usingKeyboard = false;
+    connected = gamepadId >= 0;
 
     if (gamepadId < 0)
     {
@@ -68,15 +70,13 @@ void Player::update()
                 IsGamepadButtonDown (gamepadId, GAMEPAD_BUTTON_RIGHT_TRIGGER_1);
 
     // A button places obstacle during placement phase
-    placeInput = IsGamepadButtonPressed (gamepadId, GAMEPAD_BUTTON_RIGHT_FACE_DOWN);
+    placeInput = placeInput || IsGamepadButtonPressed (gamepadId, GAMEPAD_BUTTON_RIGHT_FACE_DOWN);
 
     // Bumpers rotate obstacle during placement
     rotateInput = IsGamepadButtonDown (gamepadId, GAMEPAD_BUTTON_LEFT_TRIGGER_1) ||
                   IsGamepadButtonDown (gamepadId, GAMEPAD_BUTTON_RIGHT_TRIGGER_1);
 
     // D-pad navigation for selection grid
-    navX = 0;
-    navY = 0;
     if (IsGamepadButtonPressed (gamepadId, GAMEPAD_BUTTON_LEFT_FACE_LEFT))
         navX = -1;
     if (IsGamepadButtonPressed (gamepadId, GAMEPAD_BUTTON_LEFT_FACE_RIGHT))
@@ -86,7 +86,7 @@ void Player::update()
     if (IsGamepadButtonPressed (gamepadId, GAMEPAD_BUTTON_LEFT_FACE_DOWN))
         navY = 1;
 
-    confirmInput = IsGamepadButtonPressed (gamepadId, GAMEPAD_BUTTON_RIGHT_FACE_DOWN);
+    confirmInput = confirmInput || IsGamepadButtonPressed (gamepadId, GAMEPAD_BUTTON_RIGHT_FACE_DOWN);
 }
 
 void Player::updateKeyboardMouse()
@@ -115,14 +115,12 @@ void Player::updateKeyboardMouse()
     fireInput = IsMouseButtonDown (MOUSE_BUTTON_LEFT);
 
     // Left click or Enter to place obstacle
-    placeInput = IsMouseButtonPressed (MOUSE_BUTTON_LEFT) || IsKeyPressed (KEY_ENTER);
+    placeInput = placeInput || IsMouseButtonPressed (MOUSE_BUTTON_LEFT) || IsKeyPressed (KEY_ENTER);
 
     // Arrow keys, Q/E to rotate obstacle during placement
     rotateInput = IsKeyDown (KEY_Q) || IsKeyDown (KEY_E);
 
     // Arrow keys / WASD for grid navigation in selection phase
-    navX = 0;
-    navY = 0;
     if (IsKeyPressed (KEY_LEFT) || IsKeyPressed (KEY_A))
         navX = -1;
     if (IsKeyPressed (KEY_RIGHT) || IsKeyPressed (KEY_D))
@@ -132,7 +130,47 @@ void Player::updateKeyboardMouse()
     if (IsKeyPressed (KEY_DOWN) || IsKeyPressed (KEY_S))
         navY = 1;
 
-    confirmInput = IsKeyPressed (KEY_ENTER) || IsKeyPressed (KEY_SPACE);
+    confirmInput = confirmInput || IsKeyPressed (KEY_ENTER) || IsKeyPressed (KEY_SPACE);
+}
+
+void Player::clearPressedInputs()
+{
+    placeInput = false;
+    navX = 0;
+    navY = 0;
+    confirmInput = false;
+}
+
+PlayerInput Player::getInput() const
+{
+    PlayerInput input;
+    input.connected = connected;
+    input.usingMouse = usingKeyboard;
+    input.move = moveInput;
+    input.aim = aimInput;
+    input.mousePosition = mousePosition;
+    input.fire = fireInput;
+    input.place = placeInput;
+    input.rotate = rotateInput;
+    input.navX = navX;
+    input.navY = navY;
+    input.confirm = confirmInput;
+    return input;
+}
+
+void Player::setInput (const PlayerInput& input)
+{
+    connected = input.connected;
+    usingKeyboard = input.usingMouse;
+    moveInput = input.move;
+    aimInput = input.aim;
+    mousePosition = input.mousePosition;
+    fireInput = input.fire;
+    placeInput = input.place;
+    rotateInput = input.rotate;
+    navX = input.navX;
+    navY = input.navY;
+    confirmInput = input.confirm;
 }
 
 float Player::applyDeadzone (float value) const
@@ -2,6 +2,22 @@
 
 #include "Vec2.h"
 
+// Everything the game reads from a player for one simulation step
+struct PlayerInput
+{
+    bool connected = false;
+    bool usingMouse = false;
+    Vec2 move;
+    Vec2 aim;
+    Vec2 mousePosition;
+    bool fire = false;
+    bool place = false;
+    bool rotate = false;
+    int navX = 0;
+    int navY = 0;
+    bool confirm = false;
+};
+
 class Player
 {
 public:
@@ -9,13 +25,18 @@ public:
     ~Player();
 
     void update();
+    void clearPressedInputs();  // Pressed inputs latch across frames until a simulation step consumes them
+
+    // Snapshot / override the current input state (replay recording and playback)
+    PlayerInput getInput() const;
+    void setInput (const PlayerInput& input);
 
     Vec2 getMoveInput() const { return moveInput; }
     Vec2 getAimInput() const { return aimInput; }
     bool getFireInput() const { return fireInput; }
     bool getPlaceInput() const { return placeInput; }      // For placement phase
     bool getRotateInput() const { return rotateInput; }    // For rotating obstacle during placement
-    bool isConnected() const { return gamepadId >= 0 || usingKeyboard; }
+    bool isConnected() const { return connected; }
     bool isUsingMouse() const { return usingKeyboard; }
     Vec2 getMousePosition() const { return mousePosition; }
     int getPlayerIndex() const { return playerIndex; }
@@ -29,6 +50,7 @@ private:
     int playerIndex;
     int gamepadId = -1;
     bool usingKeyboard = false;
+    bool connected = false;
 
     Vec2 moveInput;
     Vec2 aimInput;
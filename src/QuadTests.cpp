@@ -0,0 +1,385 @@
+#include "QuadTests.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CAMBRAI_QUAD_SSE2 1
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #define CAMBRAI_QUAD_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace QuadTests
+{
+
+namespace
+{
+    // Corners split into x and y lanes, once for each end of every edge
+    struct EdgeLanes
+    {
+        alignas (16) float startX[4];
+        alignas (16) float startY[4];
+        alignas (16) float endX[4];
+        alignas (16) float endY[4];
+
+        explicit EdgeLanes (const Quad& corners)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                startX[i] = corners[i].x;
+                startY[i] = corners[i].y;
+                endX[i] = corners[(i + 1) % 4].x;
+                endY[i] = corners[(i + 1) % 4].y;
+            }
+        }
+    };
+
+    // Nearest of the crossings flagged in mask, first edge first on a tie
+    bool pickNearest (int mask, const float* pointX, const float* pointY, const float* distance, int& edge, Vec2& point)
+    {
+        edge = -1;
+        for (int i = 0; i < 4; ++i)
+        {
+            if ((mask & (1 << i)) && (edge < 0 || distance[i] < distance[edge]))
+                edge = i;
+        }
+
+        if (edge < 0)
+            return false;
+
+        point = { pointX[edge], pointY[edge] };
+        return true;
+    }
+
+   #if CAMBRAI_QUAD_NEON
+    // Comparisons, min and max that pick the same lane the scalar code would, even for signed zeros
+    int getMask (uint32x4_t lanes)
+    {
+        uint32_t bits[4];
+        vst1q_u32 (bits, lanes);
+        return (bits[0] ? 1 : 0) | (bits[1] ? 2 : 0) | (bits[2] ? 4 : 0) | (bits[3] ? 8 : 0);
+    }
+
+    float32x4_t pickMin (float32x4_t current, float32x4_t value) { return vbslq_f32 (vcltq_f32 (value, current), value, current); }
+    float32x4_t pickMax (float32x4_t current, float32x4_t value) { return vbslq_f32 (vcltq_f32 (current, value), value, current); }
+
+    // 32 bit NEON has no divide, and its reciprocal estimate wouldn't match the scalar result
+    float32x4_t divide (float32x4_t numerator, float32x4_t denominator)
+    {
+       #if defined(__aarch64__) || defined(_M_ARM64)
+        return vdivq_f32 (numerator, denominator);
+       #else
+        float n[4], d[4];
+        vst1q_f32 (n, numerator);
+        vst1q_f32 (d, denominator);
+        for (int i = 0; i < 4; ++i)
+            n[i] /= d[i];
+        return vld1q_f32 (n);
+       #endif
+    }
+   #endif
+}
+
+bool segmentsCross (Vec2 p1, Vec2 p2, Vec2 p3, Vec2 p4, Vec2& intersection)
+{
+    float d1 = (p4.x - p3.x) * (p1.y - p3.y) - (p4.y - p3.y) * (p1.x - p3.x);
+    float d2 = (p4.x - p3.x) * (p2.y - p3.y) - (p4.y - p3.y) * (p2.x - p3.x);
+    float d3 = (p2.x - p1.x) * (p3.y - p1.y) - (p2.y - p1.y) * (p3.x - p1.x);
+    float d4 = (p2.x - p1.x) * (p4.y - p1.y) - (p2.y - p1.y) * (p4.x - p1.x);
+
+    if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) &&
+        ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0)))
+    {
+        float t = d1 / (d1 - d2);
+        intersection.x = p1.x + t * (p2.x - p1.x);
+        intersection.y = p1.y + t * (p2.y - p1.y);
+        return true;
+    }
+    return false;
+}
+
+// =============================================================================
+// Segment against edges
+// =============================================================================
+
+bool firstEdgeCrossingScalar (Vec2 start, Vec2 end, const Quad& corners, int& edge, Vec2& point)
+{
+    float pointX[4], pointY[4], distance[4];
+    int mask = 0;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        Vec2 intersection;
+        if (segmentsCross (start, end, corners[i], corners[(i + 1) % 4], intersection))
+        {
+            mask |= 1 << i;
+            pointX[i] = intersection.x;
+            pointY[i] = intersection.y;
+            distance[i] = (intersection - start).lengthSquared();
+        }
+    }
+
+    return pickNearest (mask, pointX, pointY, distance, edge, point);
+}
+
+bool firstEdgeCrossing (Vec2 start, Vec2 end, const Quad& corners, int& edge, Vec2& point)
+{
+   #if CAMBRAI_QUAD_SSE2
+    EdgeLanes lanes (corners);
+    __m128 ax = _mm_load_ps (lanes.startX);
+    __m128 ay = _mm_load_ps (lanes.startY);
+    __m128 bx = _mm_load_ps (lanes.endX);
+    __m128 by = _mm_load_ps (lanes.endY);
+
+    __m128 p1x = _mm_set1_ps (start.x);
+    __m128 p1y = _mm_set1_ps (start.y);
+    __m128 p2x = _mm_set1_ps (end.x);
+    __m128 p2y = _mm_set1_ps (end.y);
+    __m128 pathX = _mm_set1_ps (end.x - start.x);
+    __m128 pathY = _mm_set1_ps (end.y - start.y);
+
+    // Which side of each edge the segment's ends are on, and which side of the segment each edge's ends are
+    __m128 edgeX = _mm_sub_ps (bx, ax);
+    __m128 edgeY = _mm_sub_ps (by, ay);
+    __m128 d1 = _mm_sub_ps (_mm_mul_ps (edgeX, _mm_sub_ps (p1y, ay)), _mm_mul_ps (edgeY, _mm_sub_ps (p1x, ax)));
+    __m128 d2 = _mm_sub_ps (_mm_mul_ps (edgeX, _mm_sub_ps (p2y, ay)), _mm_mul_ps (edgeY, _mm_sub_ps (p2x, ax)));
+    __m128 d3 = _mm_sub_ps (_mm_mul_ps (pathX, _mm_sub_ps (ay, p1y)), _mm_mul_ps (pathY, _mm_sub_ps (ax, p1x)));
+    __m128 d4 = _mm_sub_ps (_mm_mul_ps (pathX, _mm_sub_ps (by, p1y)), _mm_mul_ps (pathY, _mm_sub_ps (bx, p1x)));
+
+    const __m128 zero = _mm_setzero_ps();
+    __m128 edgeSplit = _mm_or_ps (_mm_and_ps (_mm_cmpgt_ps (d1, zero), _mm_cmplt_ps (d2, zero)),
+                                  _mm_and_ps (_mm_cmplt_ps (d1, zero), _mm_cmpgt_ps (d2, zero)));
+    __m128 pathSplit = _mm_or_ps (_mm_and_ps (_mm_cmpgt_ps (d3, zero), _mm_cmplt_ps (d4, zero)),
+                                  _mm_and_ps (_mm_cmplt_ps (d3, zero), _mm_cmpgt_ps (d4, zero)));
+
+    int mask = _mm_movemask_ps (_mm_and_ps (edgeSplit, pathSplit));
+    if (mask == 0)
+        return false;
+
+    // Lanes that don't cross may divide by zero here, they're never read
+    __m128 t = _mm_div_ps (d1, _mm_sub_ps (d1, d2));
+    __m128 ix = _mm_add_ps (p1x, _mm_mul_ps (t, pathX));
+    __m128 iy = _mm_add_ps (p1y, _mm_mul_ps (t, pathY));
+    __m128 dx = _mm_sub_ps (ix, p1x);
+    __m128 dy = _mm_sub_ps (iy, p1y);
+
+    alignas (16) float pointX[4], pointY[4], distance[4];
+    _mm_store_ps (pointX, ix);
+    _mm_store_ps (pointY, iy);
+    _mm_store_ps (distance, _mm_add_ps (_mm_mul_ps (dx, dx), _mm_mul_ps (dy, dy)));
+
+    return pickNearest (mask, pointX, pointY, distance, edge, point);
+   #elif CAMBRAI_QUAD_NEON
+    EdgeLanes lanes (corners);
+    float32x4_t ax = vld1q_f32 (lanes.startX);
+    float32x4_t ay = vld1q_f32 (lanes.startY);
+    float32x4_t bx = vld1q_f32 (lanes.endX);
+    float32x4_t by = vld1q_f32 (lanes.endY);
+
+    float32x4_t p1x = vdupq_n_f32 (start.x);
+    float32x4_t p1y = vdupq_n_f32 (start.y);
+    float32x4_t p2x = vdupq_n_f32 (end.x);
+    float32x4_t p2y = vdupq_n_f32 (end.y);
+    float32x4_t pathX = vdupq_n_f32 (end.x - start.x);
+    float32x4_t pathY = vdupq_n_f32 (end.y - start.y);
+
+    float32x4_t edgeX = vsubq_f32 (bx, ax);
+    float32x4_t edgeY = vsubq_f32 (by, ay);
+    float32x4_t d1 = vsubq_f32 (vmulq_f32 (edgeX, vsubq_f32 (p1y, ay)), vmulq_f32 (edgeY, vsubq_f32 (p1x, ax)));
+    float32x4_t d2 = vsubq_f32 (vmulq_f32 (edgeX, vsubq_f32 (p2y, ay)), vmulq_f32 (edgeY, vsubq_f32 (p2x, ax)));
+    float32x4_t d3 = vsubq_f32 (vmulq_f32 (pathX, vsubq_f32 (ay, p1y)), vmulq_f32 (pathY, vsubq_f32 (ax, p1x)));
+    float32x4_t d4 = vsubq_f32 (vmulq_f32 (pathX, vsubq_f32 (by, p1y)), vmulq_f32 (pathY, vsubq_f32 (bx, p1x)));
+
+    const float32x4_t zero = vdupq_n_f32 (0.0f);
+    uint32x4_t edgeSplit = vorrq_u32 (vandq_u32 (vcgtq_f32 (d1, zero), vcltq_f32 (d2, zero)),
+                                      vandq_u32 (vcltq_f32 (d1, zero), vcgtq_f32 (d2, zero)));
+    uint32x4_t pathSplit = vorrq_u32 (vandq_u32 (vcgtq_f32 (d3, zero), vcltq_f32 (d4, zero)),
+                                      vandq_u32 (vcltq_f32 (d3, zero), vcgtq_f32 (d4, zero)));
+
+    int mask = getMask (vandq_u32 (edgeSplit, pathSplit));
+    if (mask == 0)
+        return false;
+
+    float32x4_t t = divide (d1, vsubq_f32 (d1, d2));
+    float32x4_t ix = vaddq_f32 (p1x, vmulq_f32 (t, pathX));
+    float32x4_t iy = vaddq_f32 (p1y, vmulq_f32 (t, pathY));
+    float32x4_t dx = vsubq_f32 (ix, p1x);
+    float32x4_t dy = vsubq_f32 (iy, p1y);
+
+    float pointX[4], pointY[4], distance[4];
+    vst1q_f32 (pointX, ix);
+    vst1q_f32 (pointY, iy);
+    vst1q_f32 (distance, vaddq_f32 (vmulq_f32 (dx, dx), vmulq_f32 (dy, dy)));
+
+    return pickNearest (mask, pointX, pointY, distance, edge, point);
+   #else
+    return firstEdgeCrossingScalar (start, end, corners, edge, point);
+   #endif
+}
+
+// =============================================================================
+// Point in quad
+// =============================================================================
+
+bool containsScalar (const Quad& corners, Vec2 point)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        Vec2 edge = corners[(i + 1) % 4] - corners[i];
+        Vec2 toPoint = point - corners[i];
+
+        if (edge.x * toPoint.y - edge.y * toPoint.x < 0)
+            return false;
+    }
+    return true;
+}
+
+bool contains (const Quad& corners, Vec2 point)
+{
+   #if CAMBRAI_QUAD_SSE2
+    EdgeLanes lanes (corners);
+    __m128 ax = _mm_load_ps (lanes.startX);
+    __m128 ay = _mm_load_ps (lanes.startY);
+    __m128 edgeX = _mm_sub_ps (_mm_load_ps (lanes.endX), ax);
+    __m128 edgeY = _mm_sub_ps (_mm_load_ps (lanes.endY), ay);
+    __m128 toX = _mm_sub_ps (_mm_set1_ps (point.x), ax);
+    __m128 toY = _mm_sub_ps (_mm_set1_ps (point.y), ay);
+
+    __m128 cross = _mm_sub_ps (_mm_mul_ps (edgeX, toY), _mm_mul_ps (edgeY, toX));
+    return _mm_movemask_ps (_mm_cmplt_ps (cross, _mm_setzero_ps())) == 0;
+   #elif CAMBRAI_QUAD_NEON
+    EdgeLanes lanes (corners);
+    float32x4_t ax = vld1q_f32 (lanes.startX);
+    float32x4_t ay = vld1q_f32 (lanes.startY);
+    float32x4_t edgeX = vsubq_f32 (vld1q_f32 (lanes.endX), ax);
+    float32x4_t edgeY = vsubq_f32 (vld1q_f32 (lanes.endY), ay);
+    float32x4_t toX = vsubq_f32 (vdupq_n_f32 (point.x), ax);
+    float32x4_t toY = vsubq_f32 (vdupq_n_f32 (point.y), ay);
+
+    float32x4_t cross = vsubq_f32 (vmulq_f32 (edgeX, toY), vmulq_f32 (edgeY, toX));
+    return getMask (vcltq_f32 (cross, vdupq_n_f32 (0.0f))) == 0;
+   #else
+    return containsScalar (corners, point);
+   #endif
+}
+
+// =============================================================================
+// Separating axes
+// =============================================================================
+
+bool overlapScalar (const OrientedBox& a, const OrientedBox& b, Vec2& axis, float& depth)
+{
+    const Vec2 axes[4] = { a.edgeNormals[0], a.edgeNormals[1], b.edgeNormals[0], b.edgeNormals[1] };
+
+    for (int i = 0; i < 4; ++i)
+    {
+        float minA = a.corners[0].dot (axes[i]);
+        float maxA = minA;
+        float minB = b.corners[0].dot (axes[i]);
+        float maxB = minB;
+
+        for (int c = 1; c < 4; ++c)
+        {
+            float projA = a.corners[c].dot (axes[i]);
+            float projB = b.corners[c].dot (axes[i]);
+            minA = std::min (minA, projA);
+            maxA = std::max (maxA, projA);
+            minB = std::min (minB, projB);
+            maxB = std::max (maxB, projB);
+        }
+
+        if (maxA < minB || maxB < minA)
+            return false;
+
+        float axisDepth = std::min (maxA - minB, maxB - minA);
+        if (i == 0 || axisDepth < depth)
+        {
+            depth = axisDepth;
+            axis = axes[i];
+        }
+    }
+
+    return true;
+}
+
+bool overlap (const OrientedBox& a, const OrientedBox& b, Vec2& axis, float& depth)
+{
+   #if CAMBRAI_QUAD_SSE2 || CAMBRAI_QUAD_NEON
+    // One axis per lane
+    const Vec2 axes[4] = { a.edgeNormals[0], a.edgeNormals[1], b.edgeNormals[0], b.edgeNormals[1] };
+    alignas (16) float axisX[4], axisY[4], depthLanes[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        axisX[i] = axes[i].x;
+        axisY[i] = axes[i].y;
+    }
+
+   #if CAMBRAI_QUAD_SSE2
+    // min and max take the new value first, so ties and signed zeros go the way std::min and std::max send them
+    __m128 ax = _mm_load_ps (axisX);
+    __m128 ay = _mm_load_ps (axisY);
+
+    auto project = [&] (Vec2 corner) { return _mm_add_ps (_mm_mul_ps (_mm_set1_ps (corner.x), ax), _mm_mul_ps (_mm_set1_ps (corner.y), ay)); };
+
+    __m128 minA = project (a.corners[0]);
+    __m128 maxA = minA;
+    __m128 minB = project (b.corners[0]);
+    __m128 maxB = minB;
+
+    for (int c = 1; c < 4; ++c)
+    {
+        __m128 projA = project (a.corners[c]);
+        __m128 projB = project (b.corners[c]);
+        minA = _mm_min_ps (projA, minA);
+        maxA = _mm_max_ps (projA, maxA);
+        minB = _mm_min_ps (projB, minB);
+        maxB = _mm_max_ps (projB, maxB);
+    }
+
+    if (_mm_movemask_ps (_mm_or_ps (_mm_cmplt_ps (maxA, minB), _mm_cmplt_ps (maxB, minA))) != 0)
+        return false;
+
+    _mm_store_ps (depthLanes, _mm_min_ps (_mm_sub_ps (maxB, minA), _mm_sub_ps (maxA, minB)));
+   #else
+    float32x4_t ax = vld1q_f32 (axisX);
+    float32x4_t ay = vld1q_f32 (axisY);
+
+    auto project = [&] (Vec2 corner) { return vaddq_f32 (vmulq_n_f32 (ax, corner.x), vmulq_n_f32 (ay, corner.y)); };
+
+    float32x4_t minA = project (a.corners[0]);
+    float32x4_t maxA = minA;
+    float32x4_t minB = project (b.corners[0]);
+    float32x4_t maxB = minB;
+
+    for (int c = 1; c < 4; ++c)
+    {
+        float32x4_t projA = project (a.corners[c]);
+        float32x4_t projB = project (b.corners[c]);
+        minA = pickMin (minA, projA);
+        maxA = pickMax (maxA, projA);
+        minB = pickMin (minB, projB);
+        maxB = pickMax (maxB, projB);
+    }
+
+    if (getMask (vorrq_u32 (vcltq_f32 (maxA, minB), vcltq_f32 (maxB, minA))) != 0)
+        return false;
+
+    vst1q_f32 (depthLanes, pickMin (vsubq_f32 (maxA, minB), vsubq_f32 (maxB, minA)));
+   #endif
+
+    // Shallowest axis, the first one on a tie
+    for (int i = 0; i < 4; ++i)
+    {
+        if (i == 0 || depthLanes[i] < depth)
+        {
+            depth = depthLanes[i];
+            axis = axes[i];
+        }
+    }
+
+    return true;
+   #else
+    return overlapScalar (a, b, axis, depth);
+   #endif
+}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Geometry.h"
+#include "Vec2.h"
+#include <array>
+
+// =============================================================================
+// QuadTests
+// Shell and tank tests against convex quads - walls and tank hulls - run over
+// all four edges or separating axes at once with SSE2 or NEON, the same way
+// ShellPool integrates four shells at once. The scalar versions are the
+// reference and what runs everywhere else. The vector versions do the same
+// arithmetic in the same order, and QuadTests.cpp is built with multiply-add
+// fusing off, so they give the same answers bit for bit. cambrai-tests checks
+// that on whichever instruction set it's built for.
+//
+// Quads are corners in order, edge i running from corner i to corner i + 1.
+// =============================================================================
+
+namespace QuadTests
+{
+    using Quad = std::array<Vec2, 4>;
+
+    // Where two segments properly cross - touching or running along each other doesn't count
+    bool segmentsCross (Vec2 p1, Vec2 p2, Vec2 p3, Vec2 p4, Vec2& intersection);
+
+    // The edge the segment crosses nearest its start, by segmentsCross's rules
+    bool firstEdgeCrossing (Vec2 start, Vec2 end, const Quad& corners, int& edge, Vec2& point);
+    bool firstEdgeCrossingScalar (Vec2 start, Vec2 end, const Quad& corners, int& edge, Vec2& point);
+
+    // Whether the point is on or to the left of every edge, which is inside for a
+    // quad wound like OrientedBox's corners
+    bool contains (const Quad& corners, Vec2 point);
+    bool containsScalar (const Quad& corners, Vec2 point);
+
+    // Separating axis test on both boxes' edge normals, a's first. When they overlap,
+    // gives the first of the normals with the least overlap and how much that is
+    bool overlap (const OrientedBox& a, const OrientedBox& b, Vec2& axis, float& depth);
+    bool overlapScalar (const OrientedBox& a, const OrientedBox& b, Vec2& axis, float& depth);
+}
@@ -0,0 +1,91 @@
+#include "QualityGovernor.h"
+#include "Config.h"
+#include <algorithm>
+
+namespace
+{
+    // Highest quality first
+    constexpr QualityTier tiers[] = {
+        { 1.0f, 1.0f, 1.0f,  3 },
+        { 1.5f, 1.5f, 0.5f,  2 },
+        { 2.5f, 2.5f, 0.25f, 1 },
+        { 4.0f, 4.0f, 0.0f,  1 },
+    };
+
+    constexpr int tierCount = (int) (sizeof (tiers) / sizeof (tiers[0]));
+
+    constexpr float overBudget = 1.1f;          // Average this far over the budget steps down
+    constexpr float withinBudgetMargin = 1.05f; // Vsync puts frames right on the budget, allow for it
+    constexpr float minTimeBetweenChanges = 1.0f;
+    constexpr float quickUndoTime = 10.0f;      // Stepping down this soon after stepping up means the step up failed
+    constexpr float baseUpgradeHold = 5.0f;
+    constexpr float maxUpgradeHold = 60.0f;
+}
+
+bool QualityGovernor::update (float frameTime)
+{
+    if (! config.effectQualityGovernor)
+    {
+        bool changed = tier != 0;
+        tier = 0;
+        return changed;
+    }
+
+    float ms = frameTime * 1000.0f;
+
+    // Rolling sum over the last windowSize frames
+    int slot = frameCount % windowSize;
+    if (frameCount >= windowSize)
+        frameTimeSum -= frameTimes[(size_t) slot];
+    frameTimes[(size_t) slot] = ms;
+    frameTimeSum += ms;
+    frameCount++;
+
+    sinceChange += frameTime;
+
+    if (frameCount < windowSize)
+        return false;
+
+    float average = frameTimeSum / windowSize;
+    float budget = config.targetFrameTime;
+
+    if (average <= budget * withinBudgetMargin)
+        withinBudget += frameTime;
+    else
+        withinBudget = 0.0f;
+
+    if (sinceChange < minTimeBetweenChanges)
+        return false;
+
+    if (average > budget * overBudget && tier < tierCount - 1)
+    {
+        if (lastChangeWasUp && sinceChange < quickUndoTime)
+            upgradeHold = std::min (upgradeHold * 2.0f, maxUpgradeHold);
+
+        tier++;
+        sinceChange = 0.0f;
+        withinBudget = 0.0f;
+        lastChangeWasUp = false;
+        return true;
+    }
+
+    if (withinBudget >= upgradeHold && tier > 0)
+    {
+        // A step up that sticks earns back the shorter wait
+        if (lastChangeWasUp)
+            upgradeHold = baseUpgradeHold;
+
+        tier--;
+        sinceChange = 0.0f;
+        withinBudget = 0.0f;
+        lastChangeWasUp = true;
+        return true;
+    }
+
+    return false;
+}
+
+const QualityTier& QualityGovernor::getTier() const
+{
+    return tiers[std::clamp (tier, 0, tierCount - 1)];
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+
+struct QualityTier
+{
+    float smokeIntervalScale;       // Multiplies the time between smoke puffs
+    float trackMarkSpacingScale;    // Multiplies the distance between track marks
+    float trailSegmentFraction;     // Of config.shellTrailSegments, 0 = shells only
+    int explosionRings;             // Outer ring, then the core, then the middle ring
+};
+
+// =============================================================================
+// QualityGovernor
+// Watches real frame times and steps effect quality down a tier when the
+// rolling average runs over config.targetFrameTime, then back up once frames
+// have held the budget for a while. Going down is quick; going up waits
+// longer every time the last step up had to be undone soon after, so a tier
+// that only just misses the budget doesn't keep flapping.
+// =============================================================================
+
+class QualityGovernor
+{
+public:
+    // Feed the time the last frame took, returns true when the tier changed
+    bool update (float frameTime);
+
+    const QualityTier& getTier() const;
+    int getTierIndex() const { return tier; }
+
+private:
+    static constexpr int windowSize = 30;
+
+    std::array<float, windowSize> frameTimes = {};
+    int frameCount = 0;
+    float frameTimeSum = 0.0f;
+
+    int tier = 0;
+    float sinceChange = 0.0f;           // Seconds since the tier last changed
+    float withinBudget = 0.0f;          // Seconds the average has held the budget
+    float upgradeHold = 5.0f;           // Seconds within budget needed to step up
+    bool lastChangeWasUp = false;
+};
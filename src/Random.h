@@ -1,53 +1,106 @@
 #pragma once
 
+#include <cstdint>
 #include <random>
 
+// =============================================================================
+// Random
+// Counter-based generator - every draw is a hash of (key, counter), so a stream
+// is just two integers. Copying a stream or forking a sub-stream is free, and
+// numbers at a given index can be read without touching shared state.
+// =============================================================================
+
 class Random
 {
 public:
-    // Get singleton instance
-    static Random& instance()
+    Random() = default;
+    explicit Random (uint64_t key_) : key (key_) {}
+
+    // Non-deterministic seed for a fresh match
+    static uint64_t makeSeed()
+    {
+        std::random_device rd;
+        return ((uint64_t) rd() << 32) ^ (uint64_t) rd();
+    }
+
+    // SplitMix64 finaliser over the key/counter pair
+    static uint64_t hash (uint64_t key, uint64_t counter)
     {
-        static Random r;
-        return r;
+        uint64_t z = key + (counter + 1) * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
     }
 
+    // Independent stream derived from this one's key - does not advance this stream
+    Random fork (uint64_t streamId) const { return Random (hash (key ^ 0x6A09E667F3BCC909ull, streamId)); }
+
+    // Stateless access to the value at a given position in the stream
+    uint64_t at (uint64_t index) const { return hash (key, index); }
+
+    uint64_t nextU64() { return hash (key, counter++); }
+
     // Random int in range [min, max] inclusive
     int nextInt (int min, int max)
     {
-        std::uniform_int_distribution<int> dist (min, max);
-        return dist (engine);
+        return min + nextInt (max - min + 1);
     }
 
     // Random int in range [0, max) exclusive
     int nextInt (int max)
     {
-        std::uniform_int_distribution<int> dist (0, max - 1);
-        return dist (engine);
+        if (max <= 1)
+            return 0;
+        return (int) (((nextU64() >> 32) * (uint64_t) max) >> 32);
     }
 
     // Random float in range [0, 1)
     float nextFloat()
     {
-        std::uniform_real_distribution<float> dist (0.0f, 1.0f);
-        return dist (engine);
+        return (float) (nextU64() >> 40) * (1.0f / 16777216.0f);
     }
 
     // Random float in range [min, max)
     float nextFloat (float min, float max)
     {
-        std::uniform_real_distribution<float> dist (min, max);
-        return dist (engine);
+        return min + nextFloat() * (max - min);
     }
 
-private:
-    Random() : engine (std::random_device{}()) {}
+    uint64_t getKey() const { return key; }
+    uint64_t getCounter() const { return counter; }
 
-    std::mt19937 engine;
+private:
+    uint64_t key = 0;
+    uint64_t counter = 0;
 };
 
-// Convenience functions
-inline int randomInt (int min, int max) { return Random::instance().nextInt (min, max); }
-inline int randomInt (int max) { return Random::instance().nextInt (max); }
-inline float randomFloat() { return Random::instance().nextFloat(); }
-inline float randomFloat (float min, float max) { return Random::instance().nextFloat (min, max); }
+// =============================================================================
+// MatchRandom
+// All randomness for one match, derived from a single seed. Gameplay, AI and
+// cosmetic draws come from separate streams so that, for example, spawning
+// more smoke never changes where a portal sends a tank.
+// =============================================================================
+
+struct MatchRandom
+{
+    enum Stream : uint64_t
+    {
+        GameplayStream = 1,
+        AIStream,
+        CosmeticStream
+    };
+
+    MatchRandom() : MatchRandom (0) {}
+    explicit MatchRandom (uint64_t seed_)
+        : seed (seed_),
+          gameplay (Random (seed_).fork (GameplayStream)),
+          ai (Random (seed_).fork (AIStream)),
+          cosmetic (Random (seed_).fork (CosmeticStream))
+    {
+    }
+
+    uint64_t seed;
+    Random gameplay;    // Anything that affects the outcome: start positions, portals, magnets
+    Random ai;          // AI decisions, forked per controller
+    Random cosmetic;    // Visual only - smoke and other effects
+};
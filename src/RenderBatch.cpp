@@ -0,0 +1,201 @@
+#include "RenderBatch.h"
+#include <rlgl.h>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr float circleTolerance = 0.5f;     // Max distance between a segment and the true curve, in pixels
+}
+
+int RenderBatch::getCircleSegments (float radius)
+{
+    if (radius <= circleTolerance * 2.0f)
+        return 8;
+
+    float step = 2.0f * std::acos (1.0f - circleTolerance / radius);
+    return std::clamp ((int) std::ceil (2.0 * pi / step), 8, 96);
+}
+
+void RenderBatch::addTriangle (Vec2 a, Vec2 b, Vec2 c, Color color)
+{
+    // raylib culls clockwise triangles, so fix the winding rather than trust every caller
+    if ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x) > 0.0f)
+        std::swap (b, c);
+
+    auto& v = current->shapes;
+    v.push_back ({ a.x, a.y, 0.0f, 0.0f, color });
+    v.push_back ({ b.x, b.y, 0.0f, 0.0f, color });
+    v.push_back ({ c.x, c.y, 0.0f, 0.0f, color });
+}
+
+void RenderBatch::addQuad (Vec2 a, Vec2 b, Vec2 c, Vec2 d, Color color)
+{
+    addTriangle (a, b, c, color);
+    addTriangle (a, c, d, color);
+}
+
+void RenderBatch::addLine (Vec2 start, Vec2 end, float thickness, Color color)
+{
+    Vec2 delta = end - start;
+    float length = delta.length();
+    if (length <= 0.0f)
+        return;
+
+    Vec2 side = Vec2 (-delta.y, delta.x) * (thickness * 0.5f / length);
+    addQuad (start + side, end + side, end - side, start - side, color);
+}
+
+void RenderBatch::addFilledCircle (Vec2 center, float radius, Color color)
+{
+    addFilledOval (center, radius * 2.0f, radius * 2.0f, 0.0f, color);
+}
+
+void RenderBatch::addCircleOutline (Vec2 center, float radius, float thickness, Color color)
+{
+    addOvalOutline (center, radius * 2.0f, radius * 2.0f, 0.0f, thickness, color);
+}
+
+void RenderBatch::addFilledOval (Vec2 center, float width, float height, float angle, Color color)
+{
+    buildOval (ring, getCircleSegments (std::max (width, height) * 0.5f), center, width * 0.5f, height * 0.5f, angle);
+
+    for (size_t i = 0; i + 1 < ring.size(); ++i)
+        addTriangle (center, ring[i], ring[i + 1], color);
+}
+
+void RenderBatch::addOvalOutline (Vec2 center, float width, float height, float angle, float thickness, Color color)
+{
+    // Both rings use the outer ring's segment count so their points pair up
+    float half = thickness * 0.5f;
+    int segments = getCircleSegments (std::max (width, height) * 0.5f + half);
+    buildOval (outerRing, segments, center, width * 0.5f + half, height * 0.5f + half, angle);
+    buildOval (ring, segments, center, std::max (0.0f, width * 0.5f - half), std::max (0.0f, height * 0.5f - half), angle);
+
+    for (size_t i = 0; i + 1 < ring.size(); ++i)
+        addQuad (ring[i], outerRing[i], outerRing[i + 1], ring[i + 1], color);
+}
+
+void RenderBatch::addTexturedQuad (const Texture2D& texture, Rectangle source, Rectangle dest, Color color)
+{
+    float x0 = dest.x;
+    float y0 = dest.y;
+    float x1 = dest.x + dest.width;
+    float y1 = dest.y + dest.height;
+
+    addTexturedVertices (texture, source, { x0, y0 }, { x0, y1 }, { x1, y1 }, { x1, y0 }, color);
+}
+
+void RenderBatch::addTexturedQuad (const Texture2D& texture, Rectangle source, Vec2 center, float width, float height, float angle, Color color)
+{
+    // Rotating keeps the winding, so the corners stay in the same order as the axis aligned quad
+    Vec2 along = Vec2::fromAngle (angle) * (width * 0.5f);
+    Vec2 across = Vec2 (-along.y, along.x) * (height / width);
+
+    addTexturedVertices (texture, source, center - along - across, center - along + across,
+                         center + along + across, center + along - across, color);
+}
+
+void RenderBatch::addTexturedVertices (const Texture2D& texture, Rectangle source, Vec2 topLeft, Vec2 bottomLeft, Vec2 bottomRight, Vec2 topRight, Color color)
+{
+    auto run = std::find_if (current->textured.begin(), current->textured.end(),
+                             [&] (const TexturedRun& r) { return r.textureId == texture.id; });
+    if (run == current->textured.end())
+    {
+        current->textured.push_back ({ texture.id, 0, {} });
+        run = current->textured.end() - 1;
+    }
+
+    if (run->vertices.empty())
+        run->firstUse = nextFirstUse++;
+
+    float u0 = source.x / texture.width;
+    float v0 = source.y / texture.height;
+    float u1 = (source.x + source.width) / texture.width;
+    float v1 = (source.y + source.height) / texture.height;
+
+    // Counter-clockwise on screen, as raylib expects
+    auto& v = run->vertices;
+    v.push_back ({ topLeft.x, topLeft.y, u0, v0, color });
+    v.push_back ({ bottomLeft.x, bottomLeft.y, u0, v1, color });
+    v.push_back ({ bottomRight.x, bottomRight.y, u1, v1, color });
+    v.push_back ({ topLeft.x, topLeft.y, u0, v0, color });
+    v.push_back ({ bottomRight.x, bottomRight.y, u1, v1, color });
+    v.push_back ({ topRight.x, topRight.y, u1, v0, color });
+}
+
+void RenderBatch::flush()
+{
+    lastTriangles = 0;
+    lastDraws = 0;
+
+    for (size_t i = 0; i < layers.size(); ++i)
+        flush ((RenderLayer) i);
+
+    nextFirstUse = 0;
+}
+
+void RenderBatch::flush (RenderLayer which)
+{
+    Layer& layer = layers[(size_t) which];
+
+    submit (rlGetTextureIdDefault(), layer.shapes);
+    layer.shapes.clear();
+
+    // Textures come out in the order they were first used this frame, so sprites
+    // drawn after the tanks (shells, text) still land on top of them
+    std::sort (layer.textured.begin(), layer.textured.end(),
+               [] (const TexturedRun& a, const TexturedRun& b) { return a.firstUse < b.firstUse; });
+
+    for (auto& run : layer.textured)
+    {
+        submit (run.textureId, run.vertices);
+        run.vertices.clear();
+    }
+
+    rlSetTexture (0);
+}
+
+void RenderBatch::buildOval (std::vector<Vec2>& points, int segments, Vec2 center, float radiusX, float radiusY, float angle)
+{
+    float cosA = std::cos (angle);
+    float sinA = std::sin (angle);
+
+    points.resize ((size_t) segments + 1);
+    for (int i = 0; i < segments; ++i)
+    {
+        float theta = (float) (2.0 * pi * i / segments);
+        float x = radiusX * std::cos (theta);
+        float y = radiusY * std::sin (theta);
+        points[(size_t) i] = { center.x + x * cosA - y * sinA, center.y + x * sinA + y * cosA };
+    }
+    points[(size_t) segments] = points[0];
+}
+
+void RenderBatch::submit (unsigned int textureId, const std::vector<Vertex>& vertices)
+{
+    if (vertices.empty())
+        return;
+
+    rlSetTexture (textureId);
+    rlBegin (RL_TRIANGLES);
+
+    for (size_t i = 0; i < vertices.size(); i += 3)
+    {
+        // Keep each triangle whole if raylib's vertex buffer fills up
+        rlCheckRenderBatchLimit (3);
+
+        for (size_t j = i; j < i + 3; ++j)
+        {
+            const Vertex& v = vertices[j];
+            rlColor4ub (v.color.r, v.color.g, v.color.b, v.color.a);
+            rlTexCoord2f (v.u, v.v);
+            rlVertex2f (v.x, v.y);
+        }
+    }
+
+    rlEnd();
+
+    lastTriangles += (int) (vertices.size() / 3);
+    lastDraws++;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Vec2.h"
+#include <raylib.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+enum class RenderLayer
+{
+    World,      // Arena contents
+    Effects,    // Smoke, explosions and placement previews, over the arena's sprites
+    Overlay,    // Crosshairs, HUDs and messages over the arena
+    Count
+};
+
+// =============================================================================
+// RenderBatch
+// Records the renderer's primitives as coloured triangles instead of drawing
+// them straight away, then submits each layer in as few draws as possible:
+// all untextured triangles in one run, then one run per texture. Everything
+// is triangles - lines become thin quads - so draw order within a run is
+// kept and raylib never has to split the batch to switch primitive mode.
+//
+// Textured quads (text, tank and shell sprites) go after the layer's untextured
+// shapes, one texture after another in the order each was first used, so
+// anything that must cover them needs to be on a later layer. flush() must be
+// called before anything is drawn outside the batch, and before EndDrawing.
+// =============================================================================
+
+class RenderBatch
+{
+public:
+    void setLayer (RenderLayer layer)   { current = &layers[(size_t) layer]; }
+
+    void addTriangle (Vec2 a, Vec2 b, Vec2 c, Color color);
+    void addQuad (Vec2 a, Vec2 b, Vec2 c, Vec2 d, Color color);
+    void addLine (Vec2 start, Vec2 end, float thickness, Color color);
+    void addFilledCircle (Vec2 center, float radius, Color color);
+    void addCircleOutline (Vec2 center, float radius, float thickness, Color color);
+    void addFilledOval (Vec2 center, float width, float height, float angle, Color color);
+    void addOvalOutline (Vec2 center, float width, float height, float angle, float thickness, Color color);
+    void addTexturedQuad (const Texture2D& texture, Rectangle source, Rectangle dest, Color color);
+    void addTexturedQuad (const Texture2D& texture, Rectangle source, Vec2 center, float width, float height, float angle, Color color);
+
+    void flush();
+    void flush (RenderLayer layer);     // Just the one layer, the others keep what they have
+
+    // Segments for a circle of this radius, enough to keep the edge within half a pixel of round
+    static int getCircleSegments (float radius);
+
+    // Triangles and draw runs submitted since the last full flush started, for profiling
+    int getLastTriangleCount() const    { return lastTriangles; }
+    int getLastDrawCount() const        { return lastDraws; }
+
+private:
+    struct Vertex
+    {
+        float x, y;
+        float u, v;
+        Color color;
+    };
+
+    struct TexturedRun
+    {
+        unsigned int textureId;
+        uint32_t firstUse;          // When this flush's first quad with the texture arrived
+        std::vector<Vertex> vertices;
+    };
+
+    struct Layer
+    {
+        std::vector<Vertex> shapes;
+        std::vector<TexturedRun> textured;
+    };
+
+    std::array<Layer, (size_t) RenderLayer::Count> layers;
+    Layer* current = &layers[0];
+
+    std::vector<Vec2> ring;         // Scratch outline points for circles and ovals
+    std::vector<Vec2> outerRing;
+
+    uint32_t nextFirstUse = 0;
+
+    int lastTriangles = 0;
+    int lastDraws = 0;
+
+    static void buildOval (std::vector<Vec2>& points, int segments, Vec2 center, float radiusX, float radiusY, float angle);
+    void addTexturedVertices (const Texture2D& texture, Rectangle source, Vec2 topLeft, Vec2 bottomLeft, Vec2 bottomRight, Vec2 topRight, Color color);
+    void submit (unsigned int textureId, const std::vector<Vertex>& vertices);
+};
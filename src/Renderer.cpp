@@ -1,27 +1,28 @@
 #include "Renderer.h"
 #include "Config.h"
-#include "Obstacles/Obstacle.h"
-#include "Shell.h"
+#include "Obstacles/AllObstacles.h"
+#include "ParticleSystem.h"
+#include "ShellPool.h"
 #include "Tank.h"
+#include "World.h"
+#include <rlgl.h>
 #include <algorithm>
 #include <cmath>
 #include <vector>
 
-// Forward declare explosion struct
-struct Explosion
+namespace
 {
-    Vec2 position;
-    float timer = 0.0f;
-    float duration = 0.0f;
-    float maxRadius = 0.0f;
-
-    float getProgress() const { return timer / duration; }
-    bool isAlive() const { return timer < duration; }
-};
+    constexpr int obstacleTypeCount = (int) ObstacleType::Fan + 1;
+    constexpr float minRenderScale = 0.25f;
+}
 
 Renderer::Renderer()
 {
     createNoiseTexture();
+    createFontTexture();
+    createShellTexture();
+    createTankAtlas();
+    createThumbnailAtlas();
 }
 
 Renderer::~Renderer()
@@ -30,6 +31,20 @@ Renderer::~Renderer()
         UnloadTexture (noiseTexture1);
     if (noiseTexture2.id != 0)
         UnloadTexture (noiseTexture2);
+    if (fontTexture.id != 0)
+        UnloadTexture (fontTexture);
+    if (shellTexture.id != 0)
+        UnloadTexture (shellTexture);
+    if (staticLayer.id != 0)
+        UnloadRenderTexture (staticLayer);
+    if (trackLayer.id != 0)
+        UnloadRenderTexture (trackLayer);
+    if (tankAtlas.id != 0)
+        UnloadRenderTexture (tankAtlas);
+    if (thumbnailAtlas.id != 0)
+        UnloadRenderTexture (thumbnailAtlas);
+    if (sceneTarget.id != 0)
+        UnloadRenderTexture (sceneTarget);
 }
 
 void Renderer::clear()
@@ -42,213 +57,417 @@ void Renderer::drawDirt (float time, float screenWidth, float screenHeight)
     // Base dirt color
     ClearBackground (config.colorDirt);
 
-    // Subtle noise texture overlay for terrain variation
+    // Subtle noise texture overlay for terrain variation. Both textures wrap, so each
+    // layer is one quad whose texture coordinates run past the edge for every tile.
+    // The second layer is larger and offset so its tiling never lines up with the first
     float tileSize = noiseTextureSize * 2.0f;
+    float texelsPerPixel = noiseTextureSize / tileSize;
+    Rectangle source = { 0, 0, screenWidth * texelsPerPixel, screenHeight * texelsPerPixel };
+    batch.addTexturedQuad (noiseTexture1, source, { 0, 0, screenWidth, screenHeight }, WHITE);
+
+    float detailTileSize = tileSize * 2.7f;
+    float detailTexelsPerPixel = noiseTextureSize / detailTileSize;
+    Rectangle detailSource = { noiseTextureSize * 0.37f, noiseTextureSize * 0.61f,
+                               screenWidth * detailTexelsPerPixel, screenHeight * detailTexelsPerPixel };
+    batch.addTexturedQuad (noiseTexture2, detailSource, { 0, 0, screenWidth, screenHeight }, { 255, 255, 255, 128 });
+}
+
+void Renderer::drawStaticLayer (const ObstacleList& obstacles, float screenWidth, float screenHeight)
+{
+    int width = (int) screenWidth;
+    int height = (int) screenHeight;
+
+    staticLayerScratch.clear();
+    for (const Obstacle* obstacle : obstacles)
+    {
+        if (! isStaticObstacle (*obstacle))
+            continue;
+
+        bool revealed = obstacle->getType() != ObstacleType::Pit || static_cast<const Pit*> (obstacle)->isRevealed();
+        staticLayerScratch.push_back ({ obstacle, obstacle->getHealth(), revealed });
+    }
 
-    int tilesX = (int) (screenWidth / tileSize) + 1;
-    int tilesY = (int) (screenHeight / tileSize) + 1;
+    bool stale = staticLayerScratch != staticLayerState || width != staticLayerWidth || height != staticLayerHeight
+                 || config.getGeneration() != staticLayerGeneration;
 
-    for (int ty = 0; ty <= tilesY; ++ty)
+    if (stale)
     {
-        for (int tx = 0; tx <= tilesX; ++tx)
+        // Dirt colours come from the config too
+        if (config.getGeneration() != noiseGeneration)
         {
-            float tileX = tx * tileSize;
-            float tileY = ty * tileSize;
+            UnloadTexture (noiseTexture1);
+            UnloadTexture (noiseTexture2);
+            createNoiseTexture();
+        }
 
-            Rectangle source = { 0, 0, (float) noiseTextureSize, (float) noiseTextureSize };
-            Rectangle dest = { tileX, tileY, tileSize, tileSize };
-            DrawTexturePro (noiseTexture1, source, dest, { 0, 0 }, 0.0f, WHITE);
+        if (width != staticLayer.texture.width || height != staticLayer.texture.height)
+        {
+            if (staticLayer.id != 0)
+                UnloadRenderTexture (staticLayer);
+            staticLayer = LoadRenderTexture (width, height);
         }
+
+        staticLayerState.swap (staticLayerScratch);
+        staticLayerWidth = width;
+        staticLayerHeight = height;
+        staticLayerGeneration = config.getGeneration();
+
+        beginOffscreen (staticLayer);
+        drawDirt (0.0f, screenWidth, screenHeight);
+
+        // The noise quads are textured, so they'd go over the obstacle shapes in the same flush
+        batch.flush (RenderLayer::World);
+
+        for (const auto& state : staticLayerState)
+            drawObstacle (*state.obstacle);
+        endOffscreen();
+    }
+
+    // Render textures are stored upside down
+    Rectangle source = { 0, 0, (float) width, (float) -height };
+    DrawTextureRec (staticLayer.texture, source, { 0, 0 }, WHITE);
+}
+
+bool Renderer::isStaticObstacle (const Obstacle& obstacle)
+{
+    switch (obstacle.getType())
+    {
+        case ObstacleType::SolidWall:
+        case ObstacleType::BreakableWall:
+        case ObstacleType::ReflectiveWall:
+        case ObstacleType::RicochetWall:
+        case ObstacleType::Pit:
+            return true;
+
+        default:
+            return false;
     }
 }
 
+void Renderer::beginScene (float screenWidth, float screenHeight)
+{
+    float maxScale = std::clamp (config.renderScale, minRenderScale, 1.0f);
+    if (config.dynamicRenderScale)
+        renderScale = std::clamp (renderScale, std::clamp (config.dynamicRenderScaleMin, minRenderScale, maxScale), maxScale);
+    else
+        renderScale = maxScale;
+
+    sceneWidth = screenWidth;
+    sceneHeight = screenHeight;
+
+    // Full resolution draws straight to the window
+    if (renderScale >= 1.0f)
+        return;
+
+    // Sized for the configured scale, the dynamic mode just uses less of it
+    int width = (int) std::ceil (screenWidth * maxScale);
+    int height = (int) std::ceil (screenHeight * maxScale);
+
+    if (width != sceneTarget.texture.width || height != sceneTarget.texture.height)
+    {
+        if (sceneTarget.id != 0)
+            UnloadRenderTexture (sceneTarget);
+        sceneTarget = LoadRenderTexture (width, height);
+    }
+
+    SetTextureFilter (sceneTarget.texture, config.renderScaleSmooth ? TEXTURE_FILTER_BILINEAR : TEXTURE_FILTER_POINT);
+
+    // No clear needed, the static layer covers the whole arena
+    sceneActive = true;
+    BeginTextureMode (sceneTarget);
+    BeginMode2D (getSceneCamera());
+}
+
 void Renderer::present()
 {
+    if (sceneActive)
+    {
+        batch.flush (RenderLayer::World);
+        batch.flush (RenderLayer::Effects);
+        EndMode2D();
+        EndTextureMode();
+        sceneActive = false;
+
+        // Render textures are stored upside down, the arena is in the top left of this one
+        float usedWidth = sceneWidth * renderScale;
+        float usedHeight = sceneHeight * renderScale;
+        Rectangle source = { 0, sceneTarget.texture.height - usedHeight, usedWidth, -usedHeight };
+        DrawTexturePro (sceneTarget.texture, source, { 0, 0, sceneWidth, sceneHeight }, { 0, 0 }, 0.0f, WHITE);
+    }
+
+    batch.flush();
 }
 
-void Renderer::drawTank (const Tank& tank)
+void Renderer::updateRenderScale (float frameTime)
 {
-    Vec2 pos = tank.getPosition();
-    float angle = tank.getAngle();
-    float size = tank.getSize();
+    if (! config.dynamicRenderScale)
+        return;
 
-    // Calculate alpha for destroyed tanks
-    float alpha = 1.0f;
-    if (tank.isDestroying())
-        alpha = 1.0f - tank.getDestroyProgress();
+    // Smoothed over the last dozen or so frames
+    frameTimeAverage += (frameTime * 1000.0f - frameTimeAverage) * 0.1f;
+    renderScaleCooldown -= frameTime;
+    renderScaleClimbDelay -= frameTime;
 
-    Color tankColor = tank.getColor();
-    tankColor.a = (unsigned char) (255 * alpha);
+    if (renderScaleCooldown > 0.0f)
+        return;
 
-    // Tank body - slightly longer than wide
-    float bodyLength = size * 1.2f;
-    float bodyWidth = size * 0.8f;
+    float maxScale = std::clamp (config.renderScale, minRenderScale, 1.0f);
+    float minScale = std::clamp (config.dynamicRenderScaleMin, minRenderScale, maxScale);
+
+    // Drop quickly when over budget, climb back slowly and only once well under it,
+    // so a scale that only just misses the budget doesn't keep being retried
+    if (frameTimeAverage > config.targetFrameTime * 1.15f && renderScale > minScale)
+    {
+        renderScale = std::max (minScale, renderScale - 0.1f);
+        renderScaleCooldown = 0.5f;
+        renderScaleClimbDelay = 5.0f;
+    }
+    else if (frameTimeAverage < config.targetFrameTime * 1.05f && renderScale < maxScale && renderScaleClimbDelay <= 0.0f)
+    {
+        renderScale = std::min (maxScale, renderScale + 0.05f);
+        renderScaleCooldown = 2.0f;
+    }
+}
 
-    // Draw tank body
-    drawFilledRotatedRect (pos, bodyLength, bodyWidth, angle, tankColor);
+Camera2D Renderer::getSceneCamera() const
+{
+    Camera2D camera = { 0 };
+    camera.zoom = renderScale;
+    return camera;
+}
 
-    // Tank tracks (darker strips on sides)
-    Color trackColor = {
-        (unsigned char) (tankColor.r * 0.6f),
-        (unsigned char) (tankColor.g * 0.6f),
-        (unsigned char) (tankColor.b * 0.6f),
-        tankColor.a
-    };
+void Renderer::beginOffscreen (const RenderTexture2D& target)
+{
+    batch.flush (RenderLayer::World);
+    if (sceneActive)
+        EndMode2D();
+    BeginTextureMode (target);
+    offscreenActive = true;
+}
 
-    float cosA = std::cos (angle);
-    float sinA = std::sin (angle);
+void Renderer::endOffscreen()
+{
+    batch.flush (RenderLayer::World);
+    EndTextureMode();
+    offscreenActive = false;
 
-    float trackOffset = bodyWidth * 0.4f;
-    float trackWidth = bodyWidth * 0.2f;
+    // Texture modes don't nest, so go back to the scene if that's where the frame is being drawn
+    if (sceneActive)
+    {
+        BeginTextureMode (sceneTarget);
+        BeginMode2D (getSceneCamera());
+    }
+}
 
-    // Left track
-    Vec2 leftTrackPos = {
-        pos.x - trackOffset * sinA,
-        pos.y + trackOffset * cosA
-    };
-    drawFilledRotatedRect (leftTrackPos, bodyLength, trackWidth, angle, trackColor);
+void Renderer::beginClip (float x, float y, float width, float height)
+{
+    batch.flush (RenderLayer::World);
 
-    // Right track
-    Vec2 rightTrackPos = {
-        pos.x + trackOffset * sinA,
-        pos.y - trackOffset * cosA
-    };
-    drawFilledRotatedRect (rightTrackPos, bodyLength, trackWidth, angle, trackColor);
+    // Scissor rectangles are in target pixels, not world units - only the scene target is zoomed
+    float scale = sceneActive && ! offscreenActive ? renderScale : 1.0f;
+    BeginScissorMode ((int) (x * scale), (int) (y * scale), (int) std::ceil (width * scale), (int) std::ceil (height * scale));
+}
 
-    // Turret base (circular)
-    float turretBaseRadius = size * 0.3f;
-    Color turretBaseColor = {
-        (unsigned char) (tankColor.r * 0.8f),
-        (unsigned char) (tankColor.g * 0.8f),
-        (unsigned char) (tankColor.b * 0.8f),
-        tankColor.a
-    };
-    drawFilledCircle (pos, turretBaseRadius, turretBaseColor);
+void Renderer::endClip()
+{
+    batch.flush (RenderLayer::World);
+    EndScissorMode();
+}
 
-    // Turret barrel
-    float worldTurretAngle = angle + tank.getTurretAngle();
-    float barrelLength = size * 0.7f;
-    float barrelWidth = size * 0.12f;
+void Renderer::setEffectDetail (float trailFraction, int rings)
+{
+    trailSegmentFraction = std::clamp (trailFraction, 0.0f, 1.0f);
+    explosionRings = std::clamp (rings, 1, 3);
+}
 
-    Vec2 barrelDir = Vec2::fromAngle (worldTurretAngle);
-    Vec2 barrelCenter = pos + barrelDir * (barrelLength * 0.5f);
+void Renderer::drawTank (const Tank& tank)
+{
+    // Fade destroyed tanks out as a whole
+    float alpha = 1.0f;
+    if (tank.isDestroying())
+        alpha = 1.0f - tank.getDestroyProgress();
 
-    Color barrelColor = { config.colorBarrel.r, config.colorBarrel.g, config.colorBarrel.b, tankColor.a };
-    drawFilledRotatedRect (barrelCenter, barrelLength, barrelWidth, worldTurretAngle, barrelColor);
+    int row = std::clamp (tank.getPlayerIndex(), 0, tankPlayerRows - 1);
+    int damageStep = std::clamp ((int) (tank.getDamagePercent() * tankDamageSteps), 0, tankDamageSteps - 1);
 
-    // Outline
-    Color outlineColor = {
-        (unsigned char) (tankColor.r * 0.4f),
-        (unsigned char) (tankColor.g * 0.4f),
-        (unsigned char) (tankColor.b * 0.4f),
-        tankColor.a
-    };
-    drawRotatedRect (pos, bodyLength, bodyWidth, angle, outlineColor);
+    drawTankSprite (tank.getRenderPosition (interpolation), tank.getRenderAngle (interpolation),
+                    tank.getRenderTurretAngle (interpolation), tank.getSize(), row, damageStep,
+                    { 255, 255, 255, (unsigned char) (255 * alpha) });
 }
 
 void Renderer::drawTankGhost (const Tank& tank)
 {
-    Vec2 pos = tank.getPosition();
-    float angle = tank.getAngle();
-    float size = tank.getSize();
+    // Semi-transparent grey
+    drawTankSprite (tank.getPosition(), tank.getAngle(), tank.getTurretAngle(), tank.getSize(),
+                    tankPlayerRows, 0, { 255, 255, 255, 100 });
+}
 
-    // Semi-transparent grey color
-    Color ghostColor = { 100, 100, 100, 100 };
+void Renderer::drawTankSprite (Vec2 pos, float angle, float turretAngle, float size, int row, int damageStep, Color tint)
+{
+    if (config.getGeneration() != tankAtlasGeneration)
+    {
+        // Baking draws through the batch, so anything already queued has to go first
+        batch.flush (RenderLayer::World);
+        UnloadRenderTexture (tankAtlas);
+        createTankAtlas();
+    }
+
+    float cell = (float) tankAtlasCellSize;
+    float atlasHeight = (float) tankAtlas.texture.height;
+    float cellY = row * cell;
+
+    // Render textures are stored upside down
+    Rectangle hullSource = { damageStep * 2 * cell, atlasHeight - cellY, cell, -cell };
+    Rectangle turretSource = { (damageStep * 2 + 1) * cell, atlasHeight - cellY, cell, -cell };
 
+    float drawSize = cell / tankSpriteScale * (size / World::TANK_SIZE);
+
+    batch.addTexturedQuad (tankAtlas.texture, hullSource, pos, drawSize, drawSize, angle, tint);
+    batch.addTexturedQuad (tankAtlas.texture, turretSource, pos, drawSize, drawSize, angle + turretAngle, tint);
+}
+
+void Renderer::drawTankHull (Vec2 pos, float size, const TankColors& colors, float lineWidth)
+{
     // Tank body - slightly longer than wide
     float bodyLength = size * 1.2f;
     float bodyWidth = size * 0.8f;
 
-    // Draw tank body
-    drawFilledRotatedRect (pos, bodyLength, bodyWidth, angle, ghostColor);
+    drawFilledRotatedRect (pos, bodyLength, bodyWidth, 0.0f, colors.body);
 
     // Tank tracks (darker strips on sides)
-    Color trackColor = { 70, 70, 70, 100 };
-
-    float cosA = std::cos (angle);
-    float sinA = std::sin (angle);
-
     float trackOffset = bodyWidth * 0.4f;
     float trackWidth = bodyWidth * 0.2f;
 
-    // Left track
-    Vec2 leftTrackPos = {
-        pos.x - trackOffset * sinA,
-        pos.y + trackOffset * cosA
-    };
-    drawFilledRotatedRect (leftTrackPos, bodyLength, trackWidth, angle, trackColor);
+    drawFilledRotatedRect ({ pos.x, pos.y + trackOffset }, bodyLength, trackWidth, 0.0f, colors.track);
+    drawFilledRotatedRect ({ pos.x, pos.y - trackOffset }, bodyLength, trackWidth, 0.0f, colors.track);
 
-    // Right track
-    Vec2 rightTrackPos = {
-        pos.x + trackOffset * sinA,
-        pos.y - trackOffset * cosA
-    };
-    drawFilledRotatedRect (rightTrackPos, bodyLength, trackWidth, angle, trackColor);
+    // Outline, centred on the body edge like drawRotatedRect's
+    Vec2 topLeft = { pos.x - bodyLength / 2.0f, pos.y - bodyWidth / 2.0f };
+    Vec2 bottomRight = { pos.x + bodyLength / 2.0f, pos.y + bodyWidth / 2.0f };
+    float extend = lineWidth / 2.0f;
+
+    drawLineThick ({ topLeft.x - extend, topLeft.y }, { bottomRight.x + extend, topLeft.y }, lineWidth, colors.outline);
+    drawLineThick ({ topLeft.x - extend, bottomRight.y }, { bottomRight.x + extend, bottomRight.y }, lineWidth, colors.outline);
+    drawLineThick ({ topLeft.x, topLeft.y }, { topLeft.x, bottomRight.y }, lineWidth, colors.outline);
+    drawLineThick ({ bottomRight.x, topLeft.y }, { bottomRight.x, bottomRight.y }, lineWidth, colors.outline);
+}
 
+void Renderer::drawTankTurret (Vec2 pos, float size, const TankColors& colors)
+{
     // Turret base (circular)
-    float turretBaseRadius = size * 0.3f;
-    Color turretBaseColor = { 80, 80, 80, 100 };
-    drawFilledCircle (pos, turretBaseRadius, turretBaseColor);
+    drawFilledCircle (pos, size * 0.3f, colors.turretBase);
 
     // Turret barrel
-    float worldTurretAngle = angle + tank.getTurretAngle();
     float barrelLength = size * 0.7f;
     float barrelWidth = size * 0.12f;
 
-    Vec2 barrelDir = Vec2::fromAngle (worldTurretAngle);
-    Vec2 barrelCenter = pos + barrelDir * (barrelLength * 0.5f);
-
-    Color barrelColor = { 60, 60, 60, 100 };
-    drawFilledRotatedRect (barrelCenter, barrelLength, barrelWidth, worldTurretAngle, barrelColor);
-
-    // Outline
-    Color outlineColor = { 50, 50, 50, 100 };
-    drawRotatedRect (pos, bodyLength, bodyWidth, angle, outlineColor);
+    drawFilledRotatedRect ({ pos.x + barrelLength * 0.5f, pos.y }, barrelLength, barrelWidth, 0.0f, colors.barrel);
 }
 
-void Renderer::drawTrackMarks (const Tank& tank)
+void Renderer::drawTrackMarks (const ParticleSystem& particles, float screenWidth, float screenHeight)
 {
-    for (const auto& mark : tank.getTrackMarks())
+    int width = (int) screenWidth;
+    int height = (int) screenHeight;
+    Color trackColor = config.colorTrackMark;
+
+    bool resized = width != trackLayer.texture.width || height != trackLayer.texture.height;
+    if (resized)
     {
-        unsigned char alpha = (unsigned char) (mark.alpha * config.colorTrackMark.a);
-        Color color = { config.colorTrackMark.r, config.colorTrackMark.g, config.colorTrackMark.b, alpha };
+        if (trackLayer.id != 0)
+            UnloadRenderTexture (trackLayer);
+        trackLayer = LoadRenderTexture (width, height);
+    }
 
-        float size = tank.getSize();
-        float trackOffset = size * 0.35f;
-        float cosA = std::cos (mark.angle);
-        float sinA = std::sin (mark.angle);
+    beginOffscreen (trackLayer);
 
-        // Perpendicular direction (for horizontal tread lines relative to tank)
-        float perpX = -sinA;
-        float perpY = cosA;
+    // Start over for a new round. The layer only holds coverage in its alpha,
+    // the colour is the same everywhere
+    if (resized || particles.getClearCount() != trackLayerClearCount || particles.getTime() < trackLayerTime)
+    {
+        ClearBackground ({ trackColor.r, trackColor.g, trackColor.b, 0 });
+        trackLayerClearCount = particles.getClearCount();
+        trackLayerTime = particles.getTime();
+        trackMarksStamped = 0;
+        trackFadePending = 0.0f;
+    }
 
-        float halfWidth = config.trackMarkWidth / 2.0f;
+    // Fade the whole layer linearly, as each mark used to lose its alpha over trackMarkFadeTime.
+    // Alpha is only 8 bits, so wait until there's at least one whole step to take off
+    trackFadePending += (particles.getTime() - trackLayerTime) * trackColor.a / config.trackMarkFadeTime;
+    trackLayerTime = particles.getTime();
 
-        // Draw two horizontal tread lines for left and right tracks
-        Vec2 leftCenter = {
-            mark.position.x - trackOffset * sinA,
-            mark.position.y + trackOffset * cosA
-        };
-        Vec2 rightCenter = {
-            mark.position.x + trackOffset * sinA,
-            mark.position.y - trackOffset * cosA
-        };
+    if (trackFadePending >= 1.0f)
+    {
+        int amount = std::min ((int) trackFadePending, 255);
+        trackFadePending -= (float) (int) trackFadePending;
+
+        // Colour untouched, alpha = dst - src
+        rlSetBlendFactorsSeparate (RL_ZERO, RL_ONE, RL_ONE, RL_ONE, RL_FUNC_ADD, RL_FUNC_REVERSE_SUBTRACT);
+        BeginBlendMode (BLEND_CUSTOM_SEPARATE);
+        DrawRectangle (0, 0, width, height, { 0, 0, 0, (unsigned char) amount });
+        EndBlendMode();
+    }
 
-        // Left track tread mark (horizontal line perpendicular to tank direction)
-        Vec2 leftStart = { leftCenter.x - perpX * halfWidth, leftCenter.y - perpY * halfWidth };
-        Vec2 leftEnd = { leftCenter.x + perpX * halfWidth, leftCenter.y + perpY * halfWidth };
-        drawLineThick (leftStart, leftEnd, config.trackMarkLength, color);
+    // Stamp marks made since last frame. If more were made than are kept, the
+    // oldest are lost - only happens when frames aren't being drawn
+    uint64_t count = particles.getTrackMarkCount();
+    uint64_t history = ParticleSystem::TRACK_MARK_HISTORY;
+    uint64_t first = std::max (trackMarksStamped, count > history ? count - history : 0);
 
-        // Right track tread mark
-        Vec2 rightStart = { rightCenter.x - perpX * halfWidth, rightCenter.y - perpY * halfWidth };
-        Vec2 rightEnd = { rightCenter.x + perpX * halfWidth, rightCenter.y + perpY * halfWidth };
-        drawLineThick (rightStart, rightEnd, config.trackMarkLength, color);
+    if (first < count)
+    {
+        // Colour replaced, coverage accumulates so overlapping marks get darker
+        rlSetBlendFactorsSeparate (RL_ONE, RL_ZERO, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+        BeginBlendMode (BLEND_CUSTOM_SEPARATE);
+        for (uint64_t n = first; n < count; ++n)
+            stampTrackMark (particles.getTrackMark (n), trackColor);
+        batch.flush (RenderLayer::World);
+        EndBlendMode();
     }
+    trackMarksStamped = count;
+
+    endOffscreen();
+
+    // Render textures are stored upside down
+    Rectangle source = { 0, 0, (float) width, (float) -height };
+    DrawTextureRec (trackLayer.texture, source, { 0, 0 }, WHITE);
+}
+
+void Renderer::stampTrackMark (const TrackMark& mark, Color color)
+{
+    float halfWidth = config.trackMarkWidth / 2.0f;
+    float trackOffset = mark.tankSize * 0.35f;
+    float cosA = std::cos (mark.angle);
+    float sinA = std::sin (mark.angle);
+
+    // Perpendicular direction (for horizontal tread lines relative to tank)
+    float perpX = -sinA;
+    float perpY = cosA;
+
+    // Draw two horizontal tread lines for left and right tracks
+    Vec2 leftCenter = {
+        mark.position.x - trackOffset * sinA,
+        mark.position.y + trackOffset * cosA
+    };
+    Vec2 rightCenter = {
+        mark.position.x + trackOffset * sinA,
+        mark.position.y - trackOffset * cosA
+    };
+
+    // Left track tread mark (horizontal line perpendicular to tank direction)
+    Vec2 leftStart = { leftCenter.x - perpX * halfWidth, leftCenter.y - perpY * halfWidth };
+    Vec2 leftEnd = { leftCenter.x + perpX * halfWidth, leftCenter.y + perpY * halfWidth };
+    drawLineThick (leftStart, leftEnd, config.trackMarkLength, color);
+
+    // Right track tread mark
+    Vec2 rightStart = { rightCenter.x - perpX * halfWidth, rightCenter.y - perpY * halfWidth };
+    Vec2 rightEnd = { rightCenter.x + perpX * halfWidth, rightCenter.y + perpY * halfWidth };
+    drawLineThick (rightStart, rightEnd, config.trackMarkLength, color);
 }
 
-void Renderer::drawSmoke (const Tank& tank)
+void Renderer::drawSmoke (const ParticleSystem& particles)
 {
-    for (const auto& s : tank.getSmoke())
+    for (const auto& s : particles.getSmoke())
     {
         unsigned char alpha = (unsigned char) (s.alpha * 180);
         Color color = { 80, 80, 80, alpha };
@@ -256,58 +475,79 @@ void Renderer::drawSmoke (const Tank& tank)
     }
 }
 
-void Renderer::drawShell (const Shell& shell)
+void Renderer::drawShells (const ShellPool& shells)
 {
-    Vec2 pos = shell.getPosition();
-    Vec2 vel = shell.getVelocity();
-    float radius = shell.getRadius();
+    float radius = shells.getRadius();
+
+    // Trail dots sit at the same offsets behind every shell, so work them out once.
+    // Fewer segments still cover the whole trail length, just more sparsely
+    int segments = (int) std::lround (config.shellTrailSegments * trailSegmentFraction);
 
-    // Draw trail behind shell
-    if (vel.length() > 0.1f)
+    trailSegments.clear();
+    for (int t = segments; t >= 1; --t)
     {
-        Vec2 trailDir = vel.normalized() * -1.0f;
+        float f = (float) t / segments;
+        float alpha = (1.0f - f) * 0.8f;
+
+        Color trailColor = {
+            config.colorShellTracer.r,
+            config.colorShellTracer.g,
+            config.colorShellTracer.b,
+            (unsigned char) (255 * alpha)
+        };
+        trailSegments.push_back ({ config.shellTrailLength * f, radius * (1.0f - f * 0.3f), trailColor });
+    }
 
-        for (int i = config.shellTrailSegments; i >= 1; --i)
-        {
-            float t = (float) i / config.shellTrailSegments;
-            Vec2 trailPos = pos + trailDir * (config.shellTrailLength * t);
+    Rectangle source = { 0, 0, (float) shellTextureSize, (float) shellTextureSize };
 
-            float alpha = (1.0f - t) * 0.8f;
-            float trailRadius = radius * (1.0f - t * 0.3f);
+    auto addDot = [&] (Vec2 center, float dotRadius, Color color)
+    {
+        float d = dotRadius * 2.0f;
+        batch.addTexturedQuad (shellTexture, source, { center.x - dotRadius, center.y - dotRadius, d, d }, color);
+    };
 
-            Color trailColor = {
-                config.colorShellTracer.r,
-                config.colorShellTracer.g,
-                config.colorShellTracer.b,
-                (unsigned char) (255 * alpha)
-            };
-            drawFilledCircle (trailPos, trailRadius, trailColor);
+    for (size_t i = 0; i < shells.size(); ++i)
+    {
+        Vec2 pos = shells.getRenderPosition (i, interpolation);
+        Vec2 vel = shells.getVelocity (i);
+
+        // Draw trail behind shell
+        float speed = vel.length();
+        if (speed > 0.1f)
+        {
+            Vec2 trailDir = vel * (-1.0f / speed);
+
+            for (const auto& segment : trailSegments)
+                addDot (pos + trailDir * segment.distance, segment.radius, segment.color);
         }
-    }
 
-    // Draw shell
-    drawFilledCircle (pos, radius, config.colorShell);
+        // Draw shell
+        addDot (pos, radius, config.colorShell);
+    }
 }
 
-void Renderer::drawExplosion (const Explosion& explosion)
+void Renderer::drawExplosions (const ParticleSystem& particles)
 {
-    float progress = explosion.getProgress();
-    float radius = explosion.maxRadius * std::sqrt (progress);
-    float alpha = 1.0f - progress;
+    for (const auto& explosion : particles.getExplosions())
+    {
+        float progress = explosion.getProgress();
+        float radius = explosion.maxRadius * std::sqrt (progress);
+        float alpha = 1.0f - progress;
 
-    Color outerColor = { config.colorExplosionOuter.r, config.colorExplosionOuter.g, config.colorExplosionOuter.b, (unsigned char) (alpha * config.colorExplosionOuter.a) };
-    drawCircle (explosion.position, radius, outerColor);
+        Color outerColor = { config.colorExplosionOuter.r, config.colorExplosionOuter.g, config.colorExplosionOuter.b, (unsigned char) (alpha * config.colorExplosionOuter.a) };
+        drawCircle (explosion.position, radius, outerColor);
 
-    if (radius > 5.0f)
-    {
-        Color midColor = { config.colorExplosionMid.r, config.colorExplosionMid.g, config.colorExplosionMid.b, (unsigned char) (alpha * config.colorExplosionMid.a) };
-        drawCircle (explosion.position, radius * 0.7f, midColor);
-    }
+        if (radius > 5.0f && explosionRings >= 3)
+        {
+            Color midColor = { config.colorExplosionMid.r, config.colorExplosionMid.g, config.colorExplosionMid.b, (unsigned char) (alpha * config.colorExplosionMid.a) };
+            drawCircle (explosion.position, radius * 0.7f, midColor);
+        }
 
-    if (radius > 10.0f)
-    {
-        Color coreColor = { config.colorExplosionCore.r, config.colorExplosionCore.g, config.colorExplosionCore.b, (unsigned char) (alpha * config.colorExplosionCore.a) };
-        drawFilledCircle (explosion.position, radius * 0.3f, coreColor);
+        if (radius > 10.0f && explosionRings >= 2)
+        {
+            Color coreColor = { config.colorExplosionCore.r, config.colorExplosionCore.g, config.colorExplosionCore.b, (unsigned char) (alpha * config.colorExplosionCore.a) };
+            drawFilledCircle (explosion.position, radius * 0.3f, coreColor);
+        }
     }
 }
 
@@ -340,12 +580,471 @@ void Renderer::drawCrosshair (const Tank& tank)
 
 void Renderer::drawObstacle (const Obstacle& obstacle)
 {
-    obstacle.draw (*this);
+    switch (obstacle.getType())
+    {
+        case ObstacleType::SolidWall:      drawSolidWall (static_cast<const SolidWall&> (obstacle)); break;
+        case ObstacleType::BreakableWall:  drawBreakableWall (static_cast<const BreakableWall&> (obstacle)); break;
+        case ObstacleType::ReflectiveWall: drawReflectiveWall (static_cast<const ReflectiveWall&> (obstacle)); break;
+        case ObstacleType::RicochetWall:   drawRicochetWall (static_cast<const RicochetWall&> (obstacle)); break;
+        case ObstacleType::Mine:           drawMine (static_cast<const Mine&> (obstacle)); break;
+        case ObstacleType::AutoTurret:     drawAutoTurret (static_cast<const AutoTurret&> (obstacle)); break;
+        case ObstacleType::Pit:            drawPitObstacle (static_cast<const Pit&> (obstacle)); break;
+        case ObstacleType::Portal:         drawPortal (static_cast<const Portal&> (obstacle)); break;
+        case ObstacleType::Flag:           drawFlag (static_cast<const Flag&> (obstacle)); break;
+        case ObstacleType::HealthPack:     drawHealthPack (static_cast<const HealthPack&> (obstacle)); break;
+        case ObstacleType::Electromagnet:  drawElectromagnet (static_cast<const Electromagnet&> (obstacle)); break;
+        case ObstacleType::Fan:            drawFan (static_cast<const Fan&> (obstacle)); break;
+    }
+}
+
+void Renderer::drawObstacleThumbnails (std::span<const ObstacleThumbnail> thumbnails)
+{
+    batch.flush (RenderLayer::World);
+
+    if (config.getGeneration() != thumbnailAtlasGeneration)
+    {
+        UnloadRenderTexture (thumbnailAtlas);
+        createThumbnailAtlas();
+    }
+
+    float atlasHeight = (float) thumbnailAtlas.texture.height;
+
+    for (const auto& thumbnail : thumbnails)
+    {
+        float x = (float) ((int) thumbnail.type * thumbnailWidth);
+        float y = (float) ((thumbnail.taken ? 1 : 0) * thumbnailHeight);
+
+        // Render textures are stored upside down
+        Rectangle source = { x, atlasHeight - y, (float) thumbnailWidth, (float) -thumbnailHeight };
+        batch.addTexturedQuad (thumbnailAtlas.texture, source, thumbnail.cell, WHITE);
+    }
+
+    BeginBlendMode (BLEND_ALPHA_PREMULTIPLY);
+    batch.flush (RenderLayer::World);
+    EndBlendMode();
 }
 
 void Renderer::drawObstaclePreview (const Obstacle& obstacle, bool valid)
 {
-    obstacle.drawPreview (*this, valid);
+    Color color = valid ? config.colorPlacementValid : config.colorPlacementInvalid;
+    Vec2 position = obstacle.getPosition();
+
+    switch (obstacle.getType())
+    {
+        case ObstacleType::SolidWall:
+        case ObstacleType::BreakableWall:
+        case ObstacleType::ReflectiveWall:
+        case ObstacleType::RicochetWall:
+            drawFilledRotatedRect (position, config.wallLength, config.wallThickness, obstacle.getAngle(), color);
+            break;
+
+        case ObstacleType::Mine:
+            drawFilledCircle (position, config.mineRadius, color);
+            break;
+
+        case ObstacleType::AutoTurret:
+            drawFilledCircle (position, 15.0f, color);
+            break;
+
+        case ObstacleType::Pit:
+            drawFilledCircle (position, config.pitRadius, color);
+            break;
+
+        case ObstacleType::Portal:
+            drawFilledCircle (position, config.portalRadius, color);
+            break;
+
+        case ObstacleType::Flag:
+            drawFilledCircle (position, config.flagRadius, color);
+            break;
+
+        case ObstacleType::HealthPack:
+        {
+            drawFilledCircle (position, config.healthPackRadius, color);
+
+            // Show cross icon
+            float r = config.healthPackRadius * 0.5f;
+            float thickness = r * 0.4f;
+            drawFilledRect ({ position.x - r, position.y - thickness / 2 }, r * 2, thickness, color);
+            drawFilledRect ({ position.x - thickness / 2, position.y - r }, thickness, r * 2, color);
+            break;
+        }
+
+        case ObstacleType::Electromagnet:
+        {
+            drawFilledCircle (position, config.electromagnetRadius, color);
+
+            // Show range
+            Color rangeColor = { color.r, color.g, color.b, 50 };
+            drawCircle (position, config.electromagnetRange, rangeColor);
+            break;
+        }
+
+        case ObstacleType::Fan:
+        {
+            drawFilledCircle (position, config.fanRadius, color);
+
+            // Show direction
+            Vec2 fanDir = Vec2::fromAngle (obstacle.getAngle());
+            Vec2 arrowEnd = position + fanDir * (config.fanRadius + 15.0f);
+            drawLineThick (position, arrowEnd, 3.0f, color);
+            break;
+        }
+    }
+}
+
+void Renderer::drawSolidWall (const SolidWall& wall)
+{
+    Vec2 position = wall.getPosition();
+    float angle = wall.getAngle();
+
+    drawFilledRotatedRect (position, config.wallLength, config.wallThickness, angle, config.colorSolidWall);
+    Color outline = { 60, 60, 60, 255 };
+    drawRotatedRect (position, config.wallLength, config.wallThickness, angle, outline);
+}
+
+void Renderer::drawBreakableWall (const BreakableWall& wall)
+{
+    Vec2 position = wall.getPosition();
+    float angle = wall.getAngle();
+
+    float healthPct = wall.getHealth() / wall.getMaxHealth();
+    Color color = {
+        (unsigned char) (config.colorBreakableWall.r * healthPct),
+        (unsigned char) (config.colorBreakableWall.g * healthPct),
+        (unsigned char) (config.colorBreakableWall.b * healthPct),
+        255
+    };
+    drawFilledRotatedRect (position, config.wallLength, config.wallThickness, angle, color);
+
+    // Damage cracks when damaged
+    if (healthPct < 0.7f)
+    {
+        Color crackColor = { 50, 30, 20, 200 };
+        float cosA = std::cos (angle);
+        float sinA = std::sin (angle);
+        for (int i = 0; i < 3; ++i)
+        {
+            float offset = ((float) i - 1.0f) * config.wallLength * 0.25f;
+            Vec2 crackStart = { position.x + offset * cosA, position.y + offset * sinA };
+            Vec2 crackEnd = { crackStart.x - config.wallThickness * 0.4f * sinA, crackStart.y + config.wallThickness * 0.4f * cosA };
+            drawLine (crackStart, crackEnd, crackColor);
+        }
+    }
+}
+
+void Renderer::drawReflectiveWall (const ReflectiveWall& wall)
+{
+    Vec2 position = wall.getPosition();
+    float angle = wall.getAngle();
+
+    drawFilledRotatedRect (position, config.wallLength, config.wallThickness, angle, config.colorReflectiveWall);
+
+    // Shiny highlight
+    Color highlight = { 220, 220, 255, 100 };
+    float cosA = std::cos (angle);
+    float sinA = std::sin (angle);
+    Vec2 highlightStart = { position.x - config.wallLength * 0.4f * cosA, position.y - config.wallLength * 0.4f * sinA };
+    Vec2 highlightEnd = { position.x + config.wallLength * 0.4f * cosA, position.y + config.wallLength * 0.4f * sinA };
+    drawLineThick (highlightStart, highlightEnd, 2.0f, highlight);
+}
+
+void Renderer::drawRicochetWall (const RicochetWall& wall)
+{
+    Vec2 position = wall.getPosition();
+    float angle = wall.getAngle();
+
+    // Orange/red color to distinguish from reflective wall
+    drawFilledRotatedRect (position, config.wallLength, config.wallThickness, angle, config.colorRicochetWall);
+
+    // Multiple highlight lines to show "splitting" nature
+    float cosA = std::cos (angle);
+    float sinA = std::sin (angle);
+
+    Color highlight = { 255, 200, 150, 120 };
+    for (int i = -1; i <= 1; ++i)
+    {
+        float offset = i * config.wallThickness * 0.25f;
+        Vec2 perpOffset = { -sinA * offset, cosA * offset };
+        Vec2 start = { position.x - config.wallLength * 0.35f * cosA + perpOffset.x,
+                       position.y - config.wallLength * 0.35f * sinA + perpOffset.y };
+        Vec2 end = { position.x + config.wallLength * 0.35f * cosA + perpOffset.x,
+                     position.y + config.wallLength * 0.35f * sinA + perpOffset.y };
+        drawLine (start, end, highlight);
+    }
+}
+
+void Renderer::drawMine (const Mine& mine)
+{
+    Vec2 position = mine.getPosition();
+    float radius = config.mineRadius;
+    unsigned char alpha = mine.isRevealed() ? 255 : 13;  // 0.05 * 255 ≈ 13
+
+    Color color = mine.isArmed() ? config.colorMineArmed : config.colorMine;
+    color.a = alpha;
+
+    drawFilledCircle (position, radius, color);
+
+    Color outlineColor = config.colorBlack;
+    outlineColor.a = alpha;
+    drawCircle (position, radius, outlineColor);
+
+    // Spikes
+    int spikes = 8;
+    for (int i = 0; i < spikes; ++i)
+    {
+        float spikeAngle = (2.0f * pi * i) / spikes;
+        Vec2 spikeEnd = position + Vec2::fromAngle (spikeAngle) * (radius * 1.3f);
+        drawLine (position + Vec2::fromAngle (spikeAngle) * radius, spikeEnd, outlineColor);
+    }
+
+    // Blinking light when armed
+    if (mine.isArmed())
+    {
+        float blink = std::fmod (mine.getArmTime() * 4.0f, 1.0f);
+        if (blink < 0.5f)
+        {
+            Color lightColor = { 255, 0, 0, alpha };
+            drawFilledCircle (position, radius * 0.2f, lightColor);
+        }
+    }
+    else
+    {
+        // Arming progress
+        float progress = mine.getArmProgress();
+        Color progressColor = { 255, 200, 0, alpha };
+        drawFilledCircle (position, radius * 0.3f * progress, progressColor);
+    }
+}
+
+void Renderer::drawAutoTurret (const AutoTurret& turret)
+{
+    Vec2 position = turret.getPosition();
+
+    // Base
+    drawFilledCircle (position, 15.0f, config.colorAutoTurret);
+    drawCircle (position, 15.0f, config.colorBlack);
+
+    // Barrel
+    Vec2 barrelDir = Vec2::fromAngle (turret.getTurretAngle());
+    Vec2 barrelEnd = position + barrelDir * 25.0f;
+    drawLineThick (position, barrelEnd, 4.0f, config.colorBarrel);
+
+    // Reload indicator
+    float progress = turret.getReloadProgress();
+    if (progress < 1.0f)
+    {
+        Color reloadColor = { 255, (unsigned char) (255 * progress), 0, 200 };
+        drawFilledCircle (position, 5.0f * progress, reloadColor);
+    }
+    else
+    {
+        drawFilledCircle (position, 5.0f, config.colorReloadReady);
+    }
+}
+
+void Renderer::drawPitObstacle (const Pit& pit)
+{
+    Vec2 position = pit.getPosition();
+    unsigned char alpha = pit.isRevealed() ? 255 : 13;  // 0.05 * 255 ≈ 13
+
+    // Dark pit with concentric rings for depth effect
+    Color pitColor = config.colorPit;
+    pitColor.a = alpha;
+    drawFilledCircle (position, config.pitRadius, pitColor);
+
+    // Inner darker ring
+    Color innerColor = { 20, 15, 10, alpha };
+    drawFilledCircle (position, config.pitRadius * 0.7f, innerColor);
+
+    // Center darkest
+    Color centerColor = { 10, 5, 0, alpha };
+    drawFilledCircle (position, config.pitRadius * 0.4f, centerColor);
+
+    // Outline
+    Color outlineColor = { 60, 50, 40, alpha };
+    drawCircle (position, config.pitRadius, outlineColor);
+}
+
+void Renderer::drawPortal (const Portal& portal)
+{
+    Vec2 position = portal.getPosition();
+    float animTimer = portal.getAnimTime();
+
+    // Swirling portal effect
+    float pulse = 0.8f + 0.2f * std::sin (animTimer * 3.0f);
+
+    // Outer glow
+    Color glowColor = { 100, 50, 200, 100 };
+    drawFilledCircle (position, config.portalRadius * 1.2f * pulse, glowColor);
+
+    // Main portal
+    drawFilledCircle (position, config.portalRadius, config.colorPortal);
+
+    // Inner swirl effect - concentric rings
+    for (int i = 0; i < 3; ++i)
+    {
+        float offset = std::fmod (animTimer * 2.0f + i * 0.33f, 1.0f);
+        float ringRadius = config.portalRadius * (0.3f + offset * 0.6f);
+        unsigned char alpha = (unsigned char) (200 * (1.0f - offset));
+        Color ringColor = { 150, 100, 255, alpha };
+        drawCircle (position, ringRadius, ringColor);
+    }
+
+    // Center bright spot
+    Color centerColor = { 200, 180, 255, 255 };
+    drawFilledCircle (position, config.portalRadius * 0.2f, centerColor);
+}
+
+void Renderer::drawFlag (const Flag& flag)
+{
+    if (!flag.isAlive())
+        return;
+
+    Vec2 position = flag.getPosition();
+
+    // Flag pole
+    Vec2 poleBase = position;
+    Vec2 poleTop = { position.x, position.y - 25.0f };
+    drawLineThick (poleBase, poleTop, 3.0f, config.colorFlagPole);
+
+    // Flag (triangle waving to the right)
+    Vec2 flagTop = poleTop;
+    Vec2 flagBottom = { position.x, position.y - 10.0f };
+    Vec2 flagTip = { position.x + 18.0f, position.y - 17.5f };
+
+    // Draw as filled triangle using lines
+    drawLineThick (flagTop, flagBottom, 2.0f, config.colorFlag);
+    drawLineThick (flagTop, flagTip, 2.0f, config.colorFlag);
+    drawLineThick (flagBottom, flagTip, 2.0f, config.colorFlag);
+
+    // Fill effect - draw multiple horizontal lines
+    for (float y = poleTop.y; y < flagBottom.y; y += 2.0f)
+    {
+        float t = (y - poleTop.y) / (flagBottom.y - poleTop.y);
+        float xEnd = position.x + 18.0f * (1.0f - std::abs (t - 0.5f) * 2.0f);
+        drawLine ({ position.x, y }, { xEnd, y }, config.colorFlag);
+    }
+
+    // Base circle
+    drawFilledCircle (poleBase, 4.0f, config.colorFlagPole);
+}
+
+void Renderer::drawHealthPack (const HealthPack& pack)
+{
+    if (!pack.isAlive())
+        return;
+
+    Vec2 position = pack.getPosition();
+
+    // Pulsing green color for health
+    float pulse = 0.8f + 0.2f * std::sin (pack.getPulsePhase());
+    Color color = { (unsigned char) (100 * pulse), (unsigned char) (220 * pulse), (unsigned char) (100 * pulse), 255 };
+
+    // Outer glow
+    Color glowColor = { color.r, color.g, color.b, 80 };
+    drawFilledCircle (position, config.healthPackRadius * 1.4f, glowColor);
+
+    // Main body
+    drawFilledCircle (position, config.healthPackRadius, color);
+    drawCircle (position, config.healthPackRadius, config.colorWhite);
+
+    // Draw cross/plus icon for health
+    Color iconColor = config.colorWhite;
+    float r = config.healthPackRadius * 0.5f;
+    float thickness = r * 0.4f;
+
+    // Horizontal bar
+    drawFilledRect ({ position.x - r, position.y - thickness / 2 }, r * 2, thickness, iconColor);
+    // Vertical bar
+    drawFilledRect ({ position.x - thickness / 2, position.y - r }, thickness, r * 2, iconColor);
+}
+
+void Renderer::drawElectromagnet (const Electromagnet& magnet)
+{
+    if (!magnet.isAlive())
+        return;
+
+    Vec2 position = magnet.getPosition();
+    bool active = magnet.isActive();
+
+    Color baseColor = active ? config.colorElectromagnetOn : config.colorElectromagnetOff;
+
+    // Draw range indicator when active (faint)
+    if (active)
+    {
+        Color rangeColor = { baseColor.r, baseColor.g, baseColor.b, 30 };
+        drawCircle (position, config.electromagnetRange, rangeColor);
+
+        // Pulsing rings when active
+        float pulseTimer = magnet.getPulseProgress();
+        float pulseRadius = config.electromagnetRadius + (config.electromagnetRange - config.electromagnetRadius) * pulseTimer;
+        Color pulseColor = { baseColor.r, baseColor.g, baseColor.b, (unsigned char) (100 * (1.0f - pulseTimer)) };
+        drawCircle (position, pulseRadius, pulseColor);
+    }
+
+    // Main body
+    drawFilledCircle (position, config.electromagnetRadius, baseColor);
+    drawCircle (position, config.electromagnetRadius, config.colorBlack);
+
+    // Inner core
+    Color coreColor = active ? config.colorWhite : config.colorGreyDark;
+    drawFilledCircle (position, config.electromagnetRadius * 0.4f, coreColor);
+
+    // Magnetic field lines (decorative)
+    if (active)
+    {
+        Color lineColor = { 255, 255, 255, 150 };
+        for (int i = 0; i < 4; ++i)
+        {
+            float a = magnet.getAngle() + i * pi * 0.5f;
+            Vec2 inner = position + Vec2::fromAngle (a) * (config.electromagnetRadius * 0.5f);
+            Vec2 outer = position + Vec2::fromAngle (a) * config.electromagnetRadius;
+            drawLine (inner, outer, lineColor);
+        }
+    }
+}
+
+void Renderer::drawFan (const Fan& fan)
+{
+    if (!fan.isAlive())
+        return;
+
+    Vec2 position = fan.getPosition();
+    Vec2 fanDir = Vec2::fromAngle (fan.getAngle());
+
+    // Draw wind effect (faint lines in direction of blow)
+    Color windColor = { 200, 200, 255, 40 };
+    for (int i = 0; i < 5; ++i)
+    {
+        float offset = (float) i / 4.0f - 0.5f;
+        Vec2 perpDir = { -fanDir.y, fanDir.x };
+        Vec2 startPos = position + fanDir * config.fanRadius + perpDir * offset * 30.0f;
+        Vec2 endPos = startPos + fanDir * config.fanRange * 0.8f;
+        drawLine (startPos, endPos, windColor);
+    }
+
+    // Draw fan housing (circle)
+    drawFilledCircle (position, config.fanRadius, config.colorFan);
+    drawCircle (position, config.fanRadius, config.colorBlack);
+
+    // Draw spinning blades
+    for (int i = 0; i < 4; ++i)
+    {
+        float a = fan.getBladeAngle() + i * pi * 0.5f;
+        Vec2 bladeEnd = position + Vec2::fromAngle (a) * (config.fanRadius * 0.8f);
+        drawLineThick (position, bladeEnd, 3.0f, config.colorFanBlade);
+    }
+
+    // Center hub
+    drawFilledCircle (position, config.fanRadius * 0.2f, config.colorFanBlade);
+
+    // Direction indicator
+    Vec2 arrowTip = position + fanDir * (config.fanRadius + 8.0f);
+    Vec2 arrowLeft = arrowTip - fanDir * 6.0f + Vec2 { -fanDir.y, fanDir.x } * 4.0f;
+    Vec2 arrowRight = arrowTip - fanDir * 6.0f - Vec2 { -fanDir.y, fanDir.x } * 4.0f;
+    drawLine (arrowTip, arrowLeft, config.colorBlack);
+    drawLine (arrowTip, arrowRight, config.colorBlack);
 }
 
 void Renderer::drawPit (const Obstacle& pit)
@@ -420,87 +1119,47 @@ void Renderer::drawTankHUD (const Tank& tank, int slot, int totalSlots, float sc
 
 void Renderer::drawOval (Vec2 center, float width, float height, float angle, Color color)
 {
-    float cosA = std::cos (angle);
-    float sinA = std::sin (angle);
-
-    int segments = 32;
-    for (int i = 0; i < segments; ++i)
-    {
-        float theta1 = (2.0f * pi * i) / segments;
-        float theta2 = (2.0f * pi * (i + 1)) / segments;
-
-        float x1 = (width / 2.0f) * std::cos (theta1);
-        float y1 = (height / 2.0f) * std::sin (theta1);
-        float x2 = (width / 2.0f) * std::cos (theta2);
-        float y2 = (height / 2.0f) * std::sin (theta2);
-
-        float rx1 = x1 * cosA - y1 * sinA;
-        float ry1 = x1 * sinA + y1 * cosA;
-        float rx2 = x2 * cosA - y2 * sinA;
-        float ry2 = x2 * sinA + y2 * cosA;
-
-        DrawLine ((int) (center.x + rx1), (int) (center.y + ry1),
-                  (int) (center.x + rx2), (int) (center.y + ry2), color);
-    }
+    batch.addOvalOutline (center, width, height, angle, 1.0f, color);
 }
 
 void Renderer::drawFilledOval (Vec2 center, float width, float height, float angle, Color color)
 {
-    float cosA = std::cos (angle);
-    float sinA = std::sin (angle);
-
-    int numLines = (int) (std::max (width, height) / 2.0f);
-
-    for (int i = -numLines; i <= numLines; ++i)
-    {
-        float t = (float) i / numLines;
-        float localY = t * (height / 2.0f);
-
-        float localHalfWidth = (width / 2.0f) * std::sqrt (1.0f - t * t);
-
-        if (localHalfWidth > 0.0f)
-        {
-            float x1 = -localHalfWidth;
-            float x2 = localHalfWidth;
-
-            float wx1 = x1 * cosA - localY * sinA + center.x;
-            float wy1 = x1 * sinA + localY * cosA + center.y;
-            float wx2 = x2 * cosA - localY * sinA + center.x;
-            float wy2 = x2 * sinA + localY * cosA + center.y;
-
-            DrawLine ((int) wx1, (int) wy1, (int) wx2, (int) wy2, color);
-        }
-    }
+    batch.addFilledOval (center, width, height, angle, color);
 }
 
 void Renderer::drawCircle (Vec2 center, float radius, Color color)
 {
-    DrawCircleLinesV ({ center.x, center.y }, radius, color);
+    batch.addCircleOutline (center, radius, 1.0f, color);
 }
 
 void Renderer::drawFilledCircle (Vec2 center, float radius, Color color)
 {
-    DrawCircleV ({ center.x, center.y }, radius, color);
+    batch.addFilledCircle (center, radius, color);
 }
 
 void Renderer::drawLine (Vec2 start, Vec2 end, Color color)
 {
-    DrawLineV ({ start.x, start.y }, { end.x, end.y }, color);
+    batch.addLine (start, end, 1.0f, color);
 }
 
 void Renderer::drawLineThick (Vec2 start, Vec2 end, float thickness, Color color)
 {
-    DrawLineEx ({ start.x, start.y }, { end.x, end.y }, thickness, color);
+    batch.addLine (start, end, thickness, color);
 }
 
 void Renderer::drawRect (Vec2 topLeft, float width, float height, Color color)
 {
-    DrawRectangleLinesEx ({ topLeft.x, topLeft.y, width, height }, 1.0f, color);
+    // One pixel border inside the rectangle
+    drawFilledRect (topLeft, width, 1.0f, color);
+    drawFilledRect ({ topLeft.x, topLeft.y + height - 1.0f }, width, 1.0f, color);
+    drawFilledRect ({ topLeft.x, topLeft.y + 1.0f }, 1.0f, height - 2.0f, color);
+    drawFilledRect ({ topLeft.x + width - 1.0f, topLeft.y + 1.0f }, 1.0f, height - 2.0f, color);
 }
 
 void Renderer::drawFilledRect (Vec2 topLeft, float width, float height, Color color)
 {
-    DrawRectangleV ({ topLeft.x, topLeft.y }, { width, height }, color);
+    Vec2 bottomRight = { topLeft.x + width, topLeft.y + height };
+    batch.addQuad (topLeft, { bottomRight.x, topLeft.y }, bottomRight, { topLeft.x, bottomRight.y }, color);
 }
 
 void Renderer::drawRotatedRect (Vec2 center, float width, float height, float angle, Color color)
@@ -535,10 +1194,10 @@ void Renderer::drawRotatedRect (Vec2 center, float width, float height, float an
 
 void Renderer::drawFilledRotatedRect (Vec2 center, float width, float height, float angle, Color color)
 {
-    Rectangle rect = { center.x, center.y, width, height };
-    Vector2 origin = { width / 2.0f, height / 2.0f };
-    float angleDeg = angle * (180.0f / pi);
-    DrawRectanglePro (rect, origin, angleDeg, color);
+    Vec2 along = Vec2::fromAngle (angle) * (width / 2.0f);
+    Vec2 across = Vec2::fromAngle (angle + (float) pi * 0.5f) * (height / 2.0f);
+
+    batch.addQuad (center - along - across, center + along - across, center + along + across, center - along + across, color);
 }
 
 // Simple 5x7 bitmap font patterns
@@ -633,41 +1292,28 @@ static const uint8_t* getGlyph (unsigned char c)
     }
 }
 
-void Renderer::drawChar (char c, Vec2 position, float scale, Color color)
-{
-    unsigned char uc = (unsigned char) c;
-    const uint8_t* glyph = getGlyph (uc);
-
-    float pixelSize = std::ceil (scale);
-
-    for (int row = 0; row < 7; ++row)
-    {
-        uint8_t rowBits = glyph[row];
-        for (int col = 0; col < 5; ++col)
-        {
-            if (rowBits & (1 << (4 - col)))
-            {
-                Rectangle rect = {
-                    position.x + col * scale,
-                    position.y + row * scale,
-                    pixelSize,
-                    pixelSize
-                };
-                DrawRectangleRec (rect, color);
-            }
-        }
-    }
-}
-
 void Renderer::drawText (const std::string& text, Vec2 position, float scale, Color color)
 {
     float charWidth = 6 * scale;
     Vec2 pos = position;
 
+    // Every glyph comes from the same texture, so all the text on a layer is one draw
     for (char c : text)
     {
-        char upper = (c >= 'a' && c <= 'z') ? (c - 32) : c;
-        drawChar (upper, pos, scale, color);
+        unsigned char upper = (unsigned char) ((c >= 'a' && c <= 'z') ? (c - 32) : c);
+
+        if (upper != ' ' && upper < 128)
+        {
+            Rectangle source = {
+                (float) ((upper % fontColumns) * fontCellSize),
+                (float) ((upper / fontColumns) * fontCellSize),
+                5.0f,
+                7.0f
+            };
+            Rectangle dest = { pos.x, pos.y, 5.0f * scale, 7.0f * scale };
+            batch.addTexturedQuad (fontTexture, source, dest, color);
+        }
+
         pos.x += charWidth;
     }
 }
@@ -691,6 +1337,7 @@ void Renderer::createNoiseTexture()
     auto generateNoiseImage = [] (unsigned int seed) -> Image
     {
         Image noiseImage = GenImageColor (noiseTextureSize, noiseTextureSize, { 0, 0, 0, 0 });
+        Color* pixels = (Color*) noiseImage.data;
 
         auto nextRandom = [&seed]() -> unsigned int
         {
@@ -698,26 +1345,18 @@ void Renderer::createNoiseTexture()
             return (seed >> 16) & 0x7FFF;
         };
 
-        for (int y = 0; y < noiseTextureSize; ++y)
+        Color dark = { config.colorDirtDark.r, config.colorDirtDark.g, config.colorDirtDark.b, 40 };
+        Color light = { config.colorDirtLight.r, config.colorDirtLight.g, config.colorDirtLight.b, 30 };
+
+        // GenImageColor gives 8-bit RGBA, so pixels can be written straight into it
+        for (int i = 0; i < noiseTextureSize * noiseTextureSize; ++i)
         {
-            for (int x = 0; x < noiseTextureSize; ++x)
-            {
-                unsigned int r = nextRandom() % 100;
-                Color pixelColor = { 0, 0, 0, 0 };
-
-                if (r < 15)
-                {
-                    // Dark spot
-                    pixelColor = { config.colorDirtDark.r, config.colorDirtDark.g, config.colorDirtDark.b, 40 };
-                }
-                else if (r < 30)
-                {
-                    // Light spot
-                    pixelColor = { config.colorDirtLight.r, config.colorDirtLight.g, config.colorDirtLight.b, 30 };
-                }
-
-                ImageDrawPixel (&noiseImage, x, y, pixelColor);
-            }
+            unsigned int r = nextRandom() % 100;
+
+            if (r < 15)
+                pixels[i] = dark;       // Dark spot
+            else if (r < 30)
+                pixels[i] = light;      // Light spot
         }
 
         return noiseImage;
@@ -727,71 +1366,155 @@ void Renderer::createNoiseTexture()
     noiseTexture1 = LoadTextureFromImage (noiseImage1);
     UnloadImage (noiseImage1);
     SetTextureFilter (noiseTexture1, TEXTURE_FILTER_BILINEAR);
+    SetTextureWrap (noiseTexture1, TEXTURE_WRAP_REPEAT);
 
     Image noiseImage2 = generateNoiseImage (67890);
     noiseTexture2 = LoadTextureFromImage (noiseImage2);
     UnloadImage (noiseImage2);
     SetTextureFilter (noiseTexture2, TEXTURE_FILTER_BILINEAR);
+    SetTextureWrap (noiseTexture2, TEXTURE_WRAP_REPEAT);
+
+    noiseGeneration = config.getGeneration();
 }
 
-bool Renderer::checkTankHit (const Tank& tank, Vec2 worldPos) const
+void Renderer::createFontTexture()
 {
-    // Simple circular hit test
-    Vec2 diff = worldPos - tank.getPosition();
-    float dist = diff.length();
-    return dist < tank.getSize() * 0.6f;
+    // One cell per 7-bit character code, lit pixels white so drawing can tint them
+    int rows = 128 / fontColumns;
+    Image fontImage = GenImageColor (fontColumns * fontCellSize, rows * fontCellSize, BLANK);
+
+    for (int c = 0; c < 128; ++c)
+    {
+        const uint8_t* glyph = getGlyph ((unsigned char) c);
+        int cellX = (c % fontColumns) * fontCellSize;
+        int cellY = (c / fontColumns) * fontCellSize;
+
+        for (int row = 0; row < 7; ++row)
+            for (int col = 0; col < 5; ++col)
+                if (glyph[row] & (1 << (4 - col)))
+                    ImageDrawPixel (&fontImage, cellX + col, cellY + row, WHITE);
+    }
+
+    fontTexture = LoadTextureFromImage (fontImage);
+    UnloadImage (fontImage);
+    SetTextureFilter (fontTexture, TEXTURE_FILTER_POINT);
 }
 
-bool Renderer::checkTankHitLine (const Tank& tank, Vec2 lineStart, Vec2 lineEnd, Vec2& hitPoint) const
+void Renderer::createShellTexture()
 {
-    // Line-circle intersection test
-    // Tank is approximated as a circle with radius = size * 0.6
-    Vec2 center = tank.getPosition();
-    float radius = tank.getSize() * 0.6f;
+    // White disc with a one pixel soft edge, tinted per dot when drawn
+    Image shellImage = GenImageColor (shellTextureSize, shellTextureSize, BLANK);
+    float center = shellTextureSize / 2.0f;
 
-    Vec2 d = lineEnd - lineStart;
-    Vec2 f = lineStart - center;
+    for (int y = 0; y < shellTextureSize; ++y)
+    {
+        for (int x = 0; x < shellTextureSize; ++x)
+        {
+            float dx = x + 0.5f - center;
+            float dy = y + 0.5f - center;
+            float coverage = std::clamp (center - std::sqrt (dx * dx + dy * dy), 0.0f, 1.0f);
+
+            if (coverage > 0.0f)
+                ImageDrawPixel (&shellImage, x, y, { 255, 255, 255, (unsigned char) (255 * coverage) });
+        }
+    }
 
-    float a = d.dot (d);
-    float b = 2.0f * f.dot (d);
-    float c = f.dot (f) - radius * radius;
+    shellTexture = LoadTextureFromImage (shellImage);
+    UnloadImage (shellImage);
+    SetTextureFilter (shellTexture, TEXTURE_FILTER_BILINEAR);
+}
 
-    float discriminant = b * b - 4.0f * a * c;
-    if (discriminant < 0)
-        return false;
+void Renderer::createThumbnailAtlas()
+{
+    thumbnailAtlas = LoadRenderTexture (obstacleTypeCount * thumbnailWidth, 2 * thumbnailHeight);
+    SetTextureFilter (thumbnailAtlas.texture, TEXTURE_FILTER_BILINEAR);
 
-    discriminant = std::sqrt (discriminant);
+    beginOffscreen (thumbnailAtlas);
+    ClearBackground (BLANK);
 
-    // Find the nearest intersection point along the line segment
-    float t1 = (-b - discriminant) / (2.0f * a);
-    float t2 = (-b + discriminant) / (2.0f * a);
+    // Colour blends as usual, coverage accumulates, which leaves the colour premultiplied
+    rlSetBlendFactorsSeparate (RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode (BLEND_CUSTOM_SEPARATE);
 
-    // Check if either intersection is within the line segment [0, 1]
-    if (t1 >= 0.0f && t1 <= 1.0f)
-    {
-        hitPoint = lineStart + d * t1;
-        return true;
-    }
-    if (t2 >= 0.0f && t2 <= 1.0f)
+    for (int row = 0; row < 2; ++row)
     {
-        hitPoint = lineStart + d * t2;
-        return true;
+        Color cellColor = row == 1 ? config.colorSelectionTaken : config.colorSelectionCell;
+
+        for (int type = 0; type < obstacleTypeCount; ++type)
+        {
+            float cellX = (float) (type * thumbnailWidth);
+            float cellY = (float) (row * thumbnailHeight);
+            drawFilledRect ({ cellX, cellY }, thumbnailWidth, thumbnailHeight, cellColor);
+
+            // Sits a little above centre, leaving room for the name underneath
+            Vec2 previewPos = { cellX + thumbnailWidth / 2.0f, cellY + thumbnailHeight / 2.0f - 10.0f };
+            auto preview = createObstacle ((ObstacleType) type, previewPos, 0.0f, -1);
+
+            beginClip (cellX, cellY, thumbnailWidth, thumbnailHeight);
+            drawObstacle (*preview);
+            endClip();
+        }
     }
 
-    return false;
+    batch.flush (RenderLayer::World);
+    EndBlendMode();
+    endOffscreen();
+
+    thumbnailAtlasGeneration = config.getGeneration();
 }
 
-bool Renderer::checkTankCollision (const Tank& tankA, const Tank& tankB, Vec2& collisionPoint) const
+void Renderer::createTankAtlas()
 {
-    Vec2 diff = tankB.getPosition() - tankA.getPosition();
-    float dist = diff.length();
-    float combinedRadius = (tankA.getSize() + tankB.getSize()) * 0.5f;
+    // Every sprite is a square cell with the tank's pivot in the middle, big enough for the
+    // hull, or for the barrel which reaches further from the pivot than the hull does
+    float bakeSize = World::TANK_SIZE * tankSpriteScale;
+    tankAtlasCellSize = (int) std::ceil (bakeSize * 1.4f) + 4;
+
+    int columns = tankDamageSteps * 2;
+    int rows = tankPlayerRows + 1;
+    tankAtlas = LoadRenderTexture (columns * tankAtlasCellSize, rows * tankAtlasCellSize);
+    SetTextureFilter (tankAtlas.texture, TEXTURE_FILTER_BILINEAR);
 
-    if (dist < combinedRadius)
+    auto shade = [] (Color c, float f) -> Color
     {
-        collisionPoint = tankA.getPosition() + diff * 0.5f;
-        return true;
+        return { (unsigned char) (c.r * f), (unsigned char) (c.g * f), (unsigned char) (c.b * f), c.a };
+    };
+
+    auto bake = [&] (int row, int damageStep, const TankColors& colors)
+    {
+        float cell = (float) tankAtlasCellSize;
+        Vec2 hullCenter = { (damageStep * 2 + 0.5f) * cell, (row + 0.5f) * cell };
+        Vec2 turretCenter = { (damageStep * 2 + 1.5f) * cell, (row + 0.5f) * cell };
+
+        drawTankHull (hullCenter, bakeSize, colors, tankSpriteScale);
+        drawTankTurret (turretCenter, bakeSize, colors);
+    };
+
+    beginOffscreen (tankAtlas);
+    ClearBackground (BLANK);
+
+    for (int row = 0; row < tankPlayerRows; ++row)
+    {
+        for (int step = 0; step < tankDamageSteps; ++step)
+        {
+            // Undamaged tanks keep their exact colour, damage scorches the paint darker
+            Color body = shade (Tank::getPlayerColor (row), 1.0f - 0.35f * step / (tankDamageSteps - 1));
+
+            TankColors colors;
+            colors.body = body;
+            colors.track = shade (body, 0.6f);
+            colors.turretBase = shade (body, 0.8f);
+            colors.barrel = config.colorBarrel;
+            colors.outline = shade (body, 0.4f);
+            bake (row, step, colors);
+        }
     }
 
-    return false;
+    // Ghost is baked opaque and drawn translucent
+    bake (tankPlayerRows, 0, { { 100, 100, 100, 255 }, { 70, 70, 70, 255 }, { 80, 80, 80, 255 },
+                               { 60, 60, 60, 255 }, { 50, 50, 50, 255 } });
+
+    endOffscreen();
+
+    tankAtlasGeneration = config.getGeneration();
 }
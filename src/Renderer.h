@@ -1,13 +1,32 @@
 #pragma once
 
+#include "RenderBatch.h"
 #include "Vec2.h"
 #include <raylib.h>
+#include <cstdint>
+#include <span>
 #include <string>
+#include <vector>
 
 class Tank;
-class Shell;
+class ShellPool;
 class Obstacle;
-struct Explosion;
+using ObstacleList = std::vector<Obstacle*>;
+class SolidWall;
+class BreakableWall;
+class ReflectiveWall;
+class RicochetWall;
+class Mine;
+class AutoTurret;
+class Pit;
+class Portal;
+class Flag;
+class HealthPack;
+class Electromagnet;
+class Fan;
+class ParticleSystem;
+struct TrackMark;
+enum class ObstacleType;
 
 class Renderer
 {
@@ -17,18 +36,59 @@ public:
 
     void clear();
     void drawDirt (float time, float screenWidth, float screenHeight);
+
+    // Dirt plus the obstacles that only change when placed, damaged or revealed,
+    // kept in a render texture that's redrawn only when one of those changes
+    void drawStaticLayer (const ObstacleList& obstacles, float screenWidth, float screenHeight);
+    void invalidateStaticLayer() { staticLayerWidth = 0; }
+    static bool isStaticObstacle (const Obstacle& obstacle);
+
+    // Starts the frame's World and Effects layers. Below full render scale they go to an
+    // off-screen target at config.renderScale of the window, which present() upscales before
+    // drawing the Overlay layer straight to the window at full resolution
+    void beginScene (float screenWidth, float screenHeight);
     void present();
 
+    // Dynamic render scale, fed the real time each frame took
+    void updateRenderScale (float frameTime);
+    float getRenderScale() const { return renderScale; }
+
+    // Everything drawn is batched per layer and submitted by present(), lower layers first.
+    // Clipping, blend modes and off-screen passes flush the World layer early, so they
+    // only work on it - the Effects and Overlay layers always wait for present()
+    void setLayer (RenderLayer layer) { batch.setLayer (layer); }
+
+    // Clip drawing to a screen rectangle, flushes the World layer either side
+    void beginClip (float x, float y, float width, float height);
+    void endClip();
+
+    // Effect detail from the quality governor
+    void setEffectDetail (float trailSegmentFraction, int explosionRings);
+
+    // Blend factor between the last two simulation steps, applied to moving objects
+    void setInterpolation (float alpha) { interpolation = alpha; }
+
     void drawTank (const Tank& tank);
     void drawTankGhost (const Tank& tank);  // Grey ghost version for placement phase
-    void drawTrackMarks (const Tank& tank);
-    void drawSmoke (const Tank& tank);
-    void drawShell (const Shell& shell);
-    void drawExplosion (const Explosion& explosion);
+    void drawTrackMarks (const ParticleSystem& particles, float screenWidth, float screenHeight);
+    void drawSmoke (const ParticleSystem& particles);
+    void drawShells (const ShellPool& shells);
+    void drawExplosions (const ParticleSystem& particles);
     void drawCrosshair (const Tank& tank);
     void drawObstacle (const Obstacle& obstacle);
     void drawObstaclePreview (const Obstacle& obstacle, bool valid);
     void drawPit (const Obstacle& pit);  // Draw pit visibly (for placement or when tank trapped)
+
+    // Selection grid cells - background plus a preview of the obstacle, drawn from
+    // thumbnails baked once per config generation
+    struct ObstacleThumbnail
+    {
+        ObstacleType type;
+        Rectangle cell;
+        bool taken;         // Use the taken cell colour
+    };
+
+    void drawObstacleThumbnails (std::span<const ObstacleThumbnail> thumbnails);
     void drawTankHUD (const Tank& tank, int slot, int totalSlots, float screenWidth, float hudWidth, float alpha = 1.0f);
 
     void drawOval (Vec2 center, float width, float height, float angle, Color color);
@@ -44,18 +104,124 @@ public:
     void drawText (const std::string& text, Vec2 position, float scale, Color color);
     void drawTextCentered (const std::string& text, Vec2 center, float scale, Color color);
 
-    float getTankSize() const { return 40.0f; }
-
-    bool checkTankHit (const Tank& tank, Vec2 worldPos) const;
-    bool checkTankHitLine (const Tank& tank, Vec2 lineStart, Vec2 lineEnd, Vec2& hitPoint) const;
-    bool checkTankCollision (const Tank& tankA, const Tank& tankB, Vec2& collisionPoint) const;
-
 private:
     void createNoiseTexture();
+    Camera2D getSceneCamera() const;
+    void beginOffscreen (const RenderTexture2D& target);   // Texture modes don't nest, these restore the scene
+    void endOffscreen();
+    void createFontTexture();
+    void createShellTexture();
+    void createTankAtlas();
+    void createThumbnailAtlas();
+    void stampTrackMark (const TrackMark& mark, Color color);
     void drawFilledOval (Vec2 center, float width, float height, float angle, Color color);
-    void drawChar (char c, Vec2 position, float scale, Color color);
+
+    struct TankColors
+    {
+        Color body;
+        Color track;
+        Color turretBase;
+        Color barrel;
+        Color outline;
+    };
+
+    void drawTankSprite (Vec2 pos, float angle, float turretAngle, float size, int row, int damageStep, Color tint);
+    void drawTankHull (Vec2 pos, float size, const TankColors& colors, float lineWidth);    // Facing along +x
+    void drawTankTurret (Vec2 pos, float size, const TankColors& colors);
+
+    void drawSolidWall (const SolidWall& wall);
+    void drawBreakableWall (const BreakableWall& wall);
+    void drawReflectiveWall (const ReflectiveWall& wall);
+    void drawRicochetWall (const RicochetWall& wall);
+    void drawMine (const Mine& mine);
+    void drawAutoTurret (const AutoTurret& turret);
+    void drawPitObstacle (const Pit& pit);
+    void drawPortal (const Portal& portal);
+    void drawFlag (const Flag& flag);
+    void drawHealthPack (const HealthPack& pack);
+    void drawElectromagnet (const Electromagnet& magnet);
+    void drawFan (const Fan& fan);
+
+    float interpolation = 1.0f;
+    RenderBatch batch;
+
+    float trailSegmentFraction = 1.0f;
+    int explosionRings = 3;
+
+    RenderTexture2D sceneTarget = { 0 };
+    bool sceneActive = false;
+    bool offscreenActive = false;           // Between beginOffscreen and endOffscreen, which draw unscaled
+    float sceneWidth = 0.0f;
+    float sceneHeight = 0.0f;
+    float renderScale = 1.0f;               // Below config.renderScale while the dynamic mode has dropped it
+    float frameTimeAverage = 0.0f;          // Milliseconds
+    float renderScaleCooldown = 0.0f;       // Seconds until the scale can change again
+    float renderScaleClimbDelay = 0.0f;     // Seconds until the scale can go back up after a drop
 
     Texture2D noiseTexture1 = { 0 };
     Texture2D noiseTexture2 = { 0 };
     static constexpr int noiseTextureSize = 128;
+    int noiseGeneration = 0;                // Config generation the noise colours came from
+
+    // Bitmap font baked into one texture, a 5x7 glyph per 8x8 cell, so a whole
+    // string is one textured quad per character in a single batch
+    Texture2D fontTexture = { 0 };
+    static constexpr int fontCellSize = 8;
+    static constexpr int fontColumns = 16;
+
+    // Shells and their trail dots are all quads of one soft disc, so any number
+    // of them is a single textured run with two triangles a dot
+    Texture2D shellTexture = { 0 };
+    static constexpr int shellTextureSize = 32;
+
+    struct TrailSegment
+    {
+        float distance;     // Behind the shell
+        float radius;
+        Color color;
+    };
+
+    std::vector<TrailSegment> trailSegments;
+
+    // Tank sprites baked once per config generation. Each row is a player colour (the
+    // last player row is grey for any extra tanks, then the ghost), each pair of columns
+    // a damage step holding the hull then the turret, so a tank is two rotated quads
+    RenderTexture2D tankAtlas = { 0 };
+    int tankAtlasCellSize = 0;
+    int tankAtlasGeneration = -1;
+    static constexpr int tankPlayerRows = 5;
+    static constexpr int tankDamageSteps = 4;
+    static constexpr float tankSpriteScale = 2.0f;    // Baked at twice size so rotated sprites stay sharp
+
+    // Selection grid previews, one column per obstacle type, untaken cells on the
+    // top row and taken on the bottom. Stored premultiplied since the cell colours
+    // are translucent
+    RenderTexture2D thumbnailAtlas = { 0 };
+    int thumbnailAtlasGeneration = -1;
+    static constexpr int thumbnailWidth = 150;
+    static constexpr int thumbnailHeight = 100;
+
+    // What the static layer was last drawn from
+    struct StaticObstacleState
+    {
+        const Obstacle* obstacle;
+        float health;
+        bool revealed;
+
+        bool operator== (const StaticObstacleState&) const = default;
+    };
+
+    RenderTexture2D staticLayer = { 0 };
+    std::vector<StaticObstacleState> staticLayerState;
+    std::vector<StaticObstacleState> staticLayerScratch;
+    int staticLayerWidth = 0;
+    int staticLayerHeight = 0;
+    int staticLayerGeneration = -1;
+
+    // Track marks are stamped into this layer once, then the whole layer fades
+    RenderTexture2D trackLayer = { 0 };
+    uint64_t trackMarksStamped = 0;
+    uint32_t trackLayerClearCount = 0;
+    float trackLayerTime = 0.0f;            // Particle time the layer has been faded up to
+    float trackFadePending = 0.0f;          // Alpha still to take off the layer, 0-255 units
 };
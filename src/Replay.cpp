@@ -0,0 +1,498 @@
+#include "Replay.h"
+#include "Platform.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    constexpr char magic[4] = { 'C', 'M', 'B', 'R' };
+    constexpr uint16_t version = 1;
+
+    // Tick flags
+    constexpr uint8_t anyButtonFlag    = 1 << 4;
+    constexpr uint8_t arenaChangedFlag = 1 << 5;
+
+    // Per-player field mask
+    constexpr uint8_t buttonsField = 1 << 0;
+    constexpr uint8_t moveField    = 1 << 1;
+    constexpr uint8_t aimField     = 1 << 2;
+    constexpr uint8_t mouseField   = 1 << 3;
+
+    float quantizeAxis (float v)
+    {
+        return std::round (std::clamp (v, -1.0f, 1.0f) * 127.0f) / 127.0f;
+    }
+
+    int8_t encodeAxis (float v)
+    {
+        return (int8_t) std::lround (std::clamp (v, -1.0f, 1.0f) * 127.0f);
+    }
+
+    float decodeAxis (int8_t v)
+    {
+        return v / 127.0f;
+    }
+
+    // connected, usingMouse, fire, place, rotate, confirm, then navX / navY as 2 bit fields
+    uint16_t packButtons (const PlayerInput& in)
+    {
+        uint16_t bits = 0;
+        bits |= in.connected  ? 1 << 0 : 0;
+        bits |= in.usingMouse ? 1 << 1 : 0;
+        bits |= in.fire       ? 1 << 2 : 0;
+        bits |= in.place      ? 1 << 3 : 0;
+        bits |= in.rotate     ? 1 << 4 : 0;
+        bits |= in.confirm    ? 1 << 5 : 0;
+        bits |= (uint16_t) ((in.navX + 1) & 3) << 6;
+        bits |= (uint16_t) ((in.navY + 1) & 3) << 8;
+        return bits;
+    }
+
+    void unpackButtons (uint16_t bits, PlayerInput& in)
+    {
+        in.connected  = (bits & (1 << 0)) != 0;
+        in.usingMouse = (bits & (1 << 1)) != 0;
+        in.fire       = (bits & (1 << 2)) != 0;
+        in.place      = (bits & (1 << 3)) != 0;
+        in.rotate     = (bits & (1 << 4)) != 0;
+        in.confirm    = (bits & (1 << 5)) != 0;
+        in.navX = (int) ((bits >> 6) & 3) - 1;
+        in.navY = (int) ((bits >> 8) & 3) - 1;
+    }
+
+    bool sameVec (const Vec2& a, const Vec2& b)
+    {
+        return a.x == b.x && a.y == b.y;
+    }
+
+    uint8_t changedFields (const PlayerInput& a, const PlayerInput& b)
+    {
+        uint8_t mask = 0;
+        if (packButtons (a) != packButtons (b))
+            mask |= buttonsField;
+        if (! sameVec (a.move, b.move))
+            mask |= moveField;
+        if (! sameVec (a.aim, b.aim))
+            mask |= aimField;
+        if (! sameVec (a.mousePosition, b.mousePosition))
+            mask |= mouseField;
+        return mask;
+    }
+
+    // ---- Writing ----
+
+    void writeU8 (std::vector<uint8_t>& out, uint8_t v)
+    {
+        out.push_back (v);
+    }
+
+    void writeU16 (std::vector<uint8_t>& out, uint16_t v)
+    {
+        out.push_back ((uint8_t) v);
+        out.push_back ((uint8_t) (v >> 8));
+    }
+
+    void writeU32 (std::vector<uint8_t>& out, uint32_t v)
+    {
+        for (int i = 0; i < 4; ++i)
+            out.push_back ((uint8_t) (v >> (i * 8)));
+    }
+
+    void writeU64 (std::vector<uint8_t>& out, uint64_t v)
+    {
+        for (int i = 0; i < 8; ++i)
+            out.push_back ((uint8_t) (v >> (i * 8)));
+    }
+
+    void writeF32 (std::vector<uint8_t>& out, float v)
+    {
+        uint32_t bits;
+        std::memcpy (&bits, &v, sizeof (bits));
+        writeU32 (out, bits);
+    }
+
+    void writeVarint (std::vector<uint8_t>& out, uint32_t v)
+    {
+        while (v >= 0x80)
+        {
+            out.push_back ((uint8_t) (v | 0x80));
+            v >>= 7;
+        }
+        out.push_back ((uint8_t) v);
+    }
+
+    void writeSignedVarint (std::vector<uint8_t>& out, int32_t v)
+    {
+        writeVarint (out, ((uint32_t) v << 1) ^ (uint32_t) (v >> 31));
+    }
+
+    // ---- Reading ----
+
+    struct ByteReader
+    {
+        const std::vector<uint8_t>& data;
+        size_t& pos;
+
+        bool has (size_t n) const { return pos + n <= data.size(); }
+
+        bool u8 (uint8_t& v)
+        {
+            if (! has (1))
+                return false;
+            v = data[pos++];
+            return true;
+        }
+
+        bool u16 (uint16_t& v)
+        {
+            if (! has (2))
+                return false;
+            v = (uint16_t) (data[pos] | (data[pos + 1] << 8));
+            pos += 2;
+            return true;
+        }
+
+        bool u32 (uint32_t& v)
+        {
+            if (! has (4))
+                return false;
+            v = 0;
+            for (int i = 0; i < 4; ++i)
+                v |= (uint32_t) data[pos + i] << (i * 8);
+            pos += 4;
+            return true;
+        }
+
+        bool u64 (uint64_t& v)
+        {
+            if (! has (8))
+                return false;
+            v = 0;
+            for (int i = 0; i < 8; ++i)
+                v |= (uint64_t) data[pos + i] << (i * 8);
+            pos += 8;
+            return true;
+        }
+
+        bool f32 (float& v)
+        {
+            uint32_t bits;
+            if (! u32 (bits))
+                return false;
+            std::memcpy (&v, &bits, sizeof (v));
+            return true;
+        }
+
+        bool varint (uint32_t& v)
+        {
+            v = 0;
+            for (int shift = 0; shift < 35; shift += 7)
+            {
+                uint8_t b;
+                if (! u8 (b))
+                    return false;
+                v |= (uint32_t) (b & 0x7F) << shift;
+                if ((b & 0x80) == 0)
+                    return true;
+            }
+            return false;
+        }
+
+        bool signedVarint (int32_t& v)
+        {
+            uint32_t z;
+            if (! varint (z))
+                return false;
+            v = (int32_t) (z >> 1) ^ -(int32_t) (z & 1);
+            return true;
+        }
+    };
+}
+
+PlayerInput quantizeInput (const PlayerInput& input)
+{
+    PlayerInput q = input;
+    q.move = { quantizeAxis (input.move.x), quantizeAxis (input.move.y) };
+    q.aim = { quantizeAxis (input.aim.x), quantizeAxis (input.aim.y) };
+    q.mousePosition = { std::round (input.mousePosition.x), std::round (input.mousePosition.y) };
+    q.navX = std::clamp (input.navX, -1, 1);
+    q.navY = std::clamp (input.navY, -1, 1);
+    return q;
+}
+
+// =============================================================================
+// ReplayWriter
+// =============================================================================
+
+void ReplayWriter::begin (const ReplayHeader& header_)
+{
+    header = header_;
+    header.tickCount = 0;
+    body.clear();
+    previous = ReplayTick();
+    unchangedTicks = 0;
+    recording = true;
+}
+
+void ReplayWriter::addTick (const ReplayTick& tick)
+{
+    if (! recording)
+        return;
+
+    uint8_t flags = tick.anyButton ? anyButtonFlag : 0;
+    uint8_t masks[ReplayTick::MAX_PLAYERS] = {};
+
+    for (int i = 0; i < ReplayTick::MAX_PLAYERS; ++i)
+    {
+        masks[i] = changedFields (tick.players[i], previous.players[i]);
+        if (masks[i] != 0)
+            flags |= (uint8_t) (1 << i);
+    }
+
+    bool arenaChanged = tick.arenaWidth != previous.arenaWidth || tick.arenaHeight != previous.arenaHeight;
+    if (arenaChanged)
+        flags |= arenaChangedFlag;
+
+    header.tickCount++;
+
+    if (flags == (previous.anyButton ? anyButtonFlag : 0))
+    {
+        unchangedTicks++;
+        return;
+    }
+
+    writeVarint (body, unchangedTicks);
+    unchangedTicks = 0;
+
+    writeU8 (body, flags);
+
+    if (arenaChanged)
+    {
+        writeU16 (body, (uint16_t) std::clamp (tick.arenaWidth, 0, 0xFFFF));
+        writeU16 (body, (uint16_t) std::clamp (tick.arenaHeight, 0, 0xFFFF));
+    }
+
+    for (int i = 0; i < ReplayTick::MAX_PLAYERS; ++i)
+    {
+        if (masks[i] == 0)
+            continue;
+
+        const PlayerInput& in = tick.players[i];
+        const PlayerInput& prev = previous.players[i];
+
+        writeU8 (body, masks[i]);
+
+        if (masks[i] & buttonsField)
+            writeU16 (body, packButtons (in));
+
+        if (masks[i] & moveField)
+        {
+            writeU8 (body, (uint8_t) encodeAxis (in.move.x));
+            writeU8 (body, (uint8_t) encodeAxis (in.move.y));
+        }
+
+        if (masks[i] & aimField)
+        {
+            writeU8 (body, (uint8_t) encodeAxis (in.aim.x));
+            writeU8 (body, (uint8_t) encodeAxis (in.aim.y));
+        }
+
+        if (masks[i] & mouseField)
+        {
+            writeSignedVarint (body, (int32_t) in.mousePosition.x - (int32_t) prev.mousePosition.x);
+            writeSignedVarint (body, (int32_t) in.mousePosition.y - (int32_t) prev.mousePosition.y);
+        }
+    }
+
+    previous = tick;
+}
+
+bool ReplayWriter::save (const std::string& path)
+{
+    if (! recording)
+        return false;
+
+    recording = false;
+
+    if (path.empty() || header.tickCount == 0)
+        return false;
+
+    std::vector<uint8_t> out;
+    out.reserve (32 + header.configJson.size() + body.size());
+
+    out.insert (out.end(), std::begin (magic), std::end (magic));
+    writeU16 (out, version);
+    writeU64 (out, header.seed);
+    writeF32 (out, header.tickRate);
+    writeU32 (out, header.tickCount);
+    writeU32 (out, (uint32_t) header.configJson.size());
+    out.insert (out.end(), header.configJson.begin(), header.configJson.end());
+    out.insert (out.end(), body.begin(), body.end());
+
+    std::ofstream file (path, std::ios::binary);
+    if (! file.is_open())
+        return false;
+
+    file.write ((const char*) out.data(), (std::streamsize) out.size());
+    return file.good();
+}
+
+std::string ReplayWriter::makeDefaultPath()
+{
+    std::string dir = Platform::getUserDataSubdirectory ("replays");
+    if (dir.empty())
+        return "";
+
+    std::time_t now = std::time (nullptr);
+    char name[64];
+    std::strftime (name, sizeof (name), "replay-%Y%m%d-%H%M%S.cbr", std::localtime (&now));
+
+    return dir + "/" + name;
+}
+
+// =============================================================================
+// ReplayReader
+// =============================================================================
+
+bool ReplayReader::load (const std::string& path)
+{
+    std::ifstream file (path, std::ios::binary);
+    if (! file.is_open())
+        return false;
+
+    data.assign (std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char>());
+
+    readPos = 0;
+    tickIndex = 0;
+    ticksUntilRecord = 0;
+    haveRecord = false;
+    current = ReplayTick();
+    header = ReplayHeader();
+
+    ByteReader reader { data, readPos };
+
+    if (! reader.has (sizeof (magic)) || std::memcmp (data.data(), magic, sizeof (magic)) != 0)
+        return false;
+    readPos += sizeof (magic);
+
+    uint16_t fileVersion;
+    uint32_t configLength;
+    if (! reader.u16 (fileVersion) || fileVersion != version)
+        return false;
+
+    if (! reader.u64 (header.seed) || ! reader.f32 (header.tickRate) ||
+        ! reader.u32 (header.tickCount) || ! reader.u32 (configLength))
+        return false;
+
+    if (! reader.has (configLength))
+        return false;
+
+    header.configJson.assign ((const char*) data.data() + readPos, configLength);
+    readPos += configLength;
+
+    return true;
+}
+
+bool ReplayReader::nextTick (ReplayTick& tick)
+{
+    if (tickIndex >= header.tickCount)
+        return false;
+
+    if (! haveRecord)
+        haveRecord = readRecordPrefix();
+
+    if (haveRecord)
+    {
+        if (ticksUntilRecord == 0)
+        {
+            if (! readRecord())
+                return false;
+            haveRecord = false;
+        }
+        else
+        {
+            ticksUntilRecord--;
+        }
+    }
+
+    tick = current;
+    tickIndex++;
+    return true;
+}
+
+bool ReplayReader::readRecordPrefix()
+{
+    ByteReader reader { data, readPos };
+    return reader.varint (ticksUntilRecord);
+}
+
+bool ReplayReader::readRecord()
+{
+    ByteReader reader { data, readPos };
+
+    uint8_t flags;
+    if (! reader.u8 (flags))
+        return false;
+
+    current.anyButton = (flags & anyButtonFlag) != 0;
+
+    if (flags & arenaChangedFlag)
+    {
+        uint16_t w, h;
+        if (! reader.u16 (w) || ! reader.u16 (h))
+            return false;
+        current.arenaWidth = w;
+        current.arenaHeight = h;
+    }
+
+    for (int i = 0; i < ReplayTick::MAX_PLAYERS; ++i)
+    {
+        if ((flags & (1 << i)) == 0)
+            continue;
+
+        PlayerInput& in = current.players[i];
+
+        uint8_t mask;
+        if (! reader.u8 (mask))
+            return false;
+
+        if (mask & buttonsField)
+        {
+            uint16_t bits;
+            if (! reader.u16 (bits))
+                return false;
+            unpackButtons (bits, in);
+        }
+
+        if (mask & moveField)
+        {
+            uint8_t x, y;
+            if (! reader.u8 (x) || ! reader.u8 (y))
+                return false;
+            in.move = { decodeAxis ((int8_t) x), decodeAxis ((int8_t) y) };
+        }
+
+        if (mask & aimField)
+        {
+            uint8_t x, y;
+            if (! reader.u8 (x) || ! reader.u8 (y))
+                return false;
+            in.aim = { decodeAxis ((int8_t) x), decodeAxis ((int8_t) y) };
+        }
+
+        if (mask & mouseField)
+        {
+            int32_t dx, dy;
+            if (! reader.signedVarint (dx) || ! reader.signedVarint (dy))
+                return false;
+            in.mousePosition = { in.mousePosition.x + (float) dx, in.mousePosition.y + (float) dy };
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Player.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// =============================================================================
+// Replay
+// A match recorded as its seed, config and the per-step input of every player.
+// Inputs are quantized before they reach the simulation, so playing the file
+// back reproduces the match exactly.
+//
+// File layout (little endian):
+//   header   "CMBR", u16 version, u64 seed, f32 tick rate, u32 tick count,
+//            u32 config length, config JSON
+//   body     one record per step that differs from the step before it:
+//            varint steps since the previous record, u8 tick flags,
+//            [u16 arena w, u16 arena h], then for each changed player a u8
+//            field mask followed by only the fields that changed
+// =============================================================================
+
+struct ReplayTick
+{
+    static constexpr int MAX_PLAYERS = 4;
+
+    std::array<PlayerInput, MAX_PLAYERS> players;
+    bool anyButton = false;             // Title / game over "press any button"
+    int arenaWidth = 0;
+    int arenaHeight = 0;
+};
+
+struct ReplayHeader
+{
+    uint64_t seed = 0;
+    float tickRate = 0.0f;
+    uint32_t tickCount = 0;
+    std::string configJson;
+};
+
+// Round an input to what the file can store, so live play and playback see the same values
+PlayerInput quantizeInput (const PlayerInput& input);
+
+class ReplayWriter
+{
+public:
+    void begin (const ReplayHeader& header);
+    void addTick (const ReplayTick& tick);
+    bool isRecording() const { return recording; }
+
+    // Writes the file and stops recording
+    bool save (const std::string& path);
+    void cancel() { recording = false; }
+
+    // Default location: <user data>/replays/<timestamp>.cbr
+    static std::string makeDefaultPath();
+
+private:
+    bool recording = false;
+    ReplayHeader header;
+    std::vector<uint8_t> body;
+    ReplayTick previous;
+    uint32_t unchangedTicks = 0;
+};
+
+class ReplayReader
+{
+public:
+    bool load (const std::string& path);
+
+    const ReplayHeader& getHeader() const { return header; }
+
+    // Decode the next step, returns false at the end of the recording
+    bool nextTick (ReplayTick& tick);
+    uint32_t getTickIndex() const { return tickIndex; }
+
+private:
+    ReplayHeader header;
+    std::vector<uint8_t> data;
+    size_t readPos = 0;
+    uint32_t tickIndex = 0;
+
+    ReplayTick current;
+    uint32_t ticksUntilRecord = 0;      // Steps that repeat `current` before the next record
+    bool haveRecord = false;
+
+    bool readRecordPrefix();
+    bool readRecord();
+};
@@ -0,0 +1,211 @@
+#include "ShellPool.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CAMBRAI_SHELL_SSE2 1
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+    #define CAMBRAI_SHELL_NEON 1
+    #include <arm_neon.h>
+#endif
+
+void ShellPool::clear()
+{
+    resize (0);
+}
+
+void ShellPool::add (const Shell& shell)
+{
+    posX.push_back (shell.position.x);
+    posY.push_back (shell.position.y);
+    prevX.push_back (shell.previousPosition.x);
+    prevY.push_back (shell.previousPosition.y);
+    startX.push_back (shell.startPosition.x);
+    startY.push_back (shell.startPosition.y);
+    velX.push_back (shell.velocity.x);
+    velY.push_back (shell.velocity.y);
+    maxRange.push_back (shell.maxRange);
+    maxRangeSq.push_back (shell.maxRange * shell.maxRange);
+    damage.push_back (shell.damage);
+    ownerIndex.push_back (shell.ownerIndex);
+    bounceCount.push_back (shell.bounceCount);
+    alive.push_back (1);
+}
+
+Shell ShellPool::get (size_t index) const
+{
+    Shell shell (getPosition (index), getVelocity (index), ownerIndex[index], maxRange[index], damage[index]);
+    shell.previousPosition = getPreviousPosition (index);
+    shell.startPosition = { startX[index], startY[index] };
+    shell.bounceCount = bounceCount[index];
+    return shell;
+}
+
+void ShellPool::reflect (size_t index, Vec2 normal, Vec2 contact)
+{
+    // v' = v - 2(v.n)n
+    Vec2 velocity = getVelocity (index);
+    velocity = velocity - normal * (2.0f * velocity.dot (normal));
+    velX[index] = velocity.x;
+    velY[index] = velocity.y;
+    bounceCount[index]++;
+
+    // Restart from the contact point, in case the step carried the shell through the
+    // wall, and push it away to prevent immediate re-collision
+    posX[index] = contact.x + normal.x * 5.0f;
+    posY[index] = contact.y + normal.y * 5.0f;
+
+    // Reset start position so shell gets fresh range after bouncing
+    startX[index] = posX[index];
+    startY[index] = posY[index];
+}
+
+void ShellPool::integrate (float dt, float arenaWidth, float arenaHeight)
+{
+    size_t count = size();
+    size_t i = 0;
+
+#if CAMBRAI_SHELL_SSE2
+    const __m128 vdt = _mm_set1_ps (dt);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 width = _mm_set1_ps (arenaWidth);
+    const __m128 height = _mm_set1_ps (arenaHeight);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 px = _mm_loadu_ps (&posX[i]);
+        __m128 py = _mm_loadu_ps (&posY[i]);
+        _mm_storeu_ps (&prevX[i], px);
+        _mm_storeu_ps (&prevY[i], py);
+
+        px = _mm_add_ps (px, _mm_mul_ps (_mm_loadu_ps (&velX[i]), vdt));
+        py = _mm_add_ps (py, _mm_mul_ps (_mm_loadu_ps (&velY[i]), vdt));
+        _mm_storeu_ps (&posX[i], px);
+        _mm_storeu_ps (&posY[i], py);
+
+        __m128 dx = _mm_sub_ps (px, _mm_loadu_ps (&startX[i]));
+        __m128 dy = _mm_sub_ps (py, _mm_loadu_ps (&startY[i]));
+        __m128 distSq = _mm_add_ps (_mm_mul_ps (dx, dx), _mm_mul_ps (dy, dy));
+
+        __m128 expired = _mm_cmpge_ps (distSq, _mm_loadu_ps (&maxRangeSq[i]));
+        expired = _mm_or_ps (expired, _mm_or_ps (_mm_cmplt_ps (px, zero), _mm_cmpgt_ps (px, width)));
+        expired = _mm_or_ps (expired, _mm_or_ps (_mm_cmplt_ps (py, zero), _mm_cmpgt_ps (py, height)));
+
+        int mask = _mm_movemask_ps (expired);
+        if (mask != 0)
+        {
+            for (int lane = 0; lane < 4; ++lane)
+                if (mask & (1 << lane))
+                    alive[i + lane] = 0;
+        }
+    }
+#elif CAMBRAI_SHELL_NEON
+    const float32x4_t zero = vdupq_n_f32 (0.0f);
+    const float32x4_t width = vdupq_n_f32 (arenaWidth);
+    const float32x4_t height = vdupq_n_f32 (arenaHeight);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t px = vld1q_f32 (&posX[i]);
+        float32x4_t py = vld1q_f32 (&posY[i]);
+        vst1q_f32 (&prevX[i], px);
+        vst1q_f32 (&prevY[i], py);
+
+        px = vaddq_f32 (px, vmulq_n_f32 (vld1q_f32 (&velX[i]), dt));
+        py = vaddq_f32 (py, vmulq_n_f32 (vld1q_f32 (&velY[i]), dt));
+        vst1q_f32 (&posX[i], px);
+        vst1q_f32 (&posY[i], py);
+
+        float32x4_t dx = vsubq_f32 (px, vld1q_f32 (&startX[i]));
+        float32x4_t dy = vsubq_f32 (py, vld1q_f32 (&startY[i]));
+        float32x4_t distSq = vaddq_f32 (vmulq_f32 (dx, dx), vmulq_f32 (dy, dy));
+
+        uint32x4_t expired = vcgeq_f32 (distSq, vld1q_f32 (&maxRangeSq[i]));
+        expired = vorrq_u32 (expired, vorrq_u32 (vcltq_f32 (px, zero), vcgtq_f32 (px, width)));
+        expired = vorrq_u32 (expired, vorrq_u32 (vcltq_f32 (py, zero), vcgtq_f32 (py, height)));
+
+        uint32_t lanes[4];
+        vst1q_u32 (lanes, expired);
+        for (int lane = 0; lane < 4; ++lane)
+            if (lanes[lane] != 0)
+                alive[i + lane] = 0;
+    }
+#endif
+
+    integrateScalar (i, count, dt, arenaWidth, arenaHeight);
+}
+
+void ShellPool::integrateScalar (size_t begin, size_t end, float dt, float arenaWidth, float arenaHeight)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        prevX[i] = posX[i];
+        prevY[i] = posY[i];
+        posX[i] += velX[i] * dt;
+        posY[i] += velY[i] * dt;
+
+        float dx = posX[i] - startX[i];
+        float dy = posY[i] - startY[i];
+
+        if (dx * dx + dy * dy >= maxRangeSq[i] ||
+            posX[i] < 0 || posX[i] > arenaWidth || posY[i] < 0 || posY[i] > arenaHeight)
+            alive[i] = 0;
+    }
+}
+
+void ShellPool::removeDead()
+{
+    size_t count = size();
+    size_t i = 0;
+
+    while (i < count)
+    {
+        if (alive[i])
+        {
+            i++;
+            continue;
+        }
+
+        // Fill the hole with the last shell and look at this slot again
+        count--;
+        if (i != count)
+            moveShell (count, i);
+    }
+
+    resize (count);
+}
+
+void ShellPool::moveShell (size_t from, size_t to)
+{
+    posX[to] = posX[from];
+    posY[to] = posY[from];
+    prevX[to] = prevX[from];
+    prevY[to] = prevY[from];
+    startX[to] = startX[from];
+    startY[to] = startY[from];
+    velX[to] = velX[from];
+    velY[to] = velY[from];
+    maxRange[to] = maxRange[from];
+    maxRangeSq[to] = maxRangeSq[from];
+    damage[to] = damage[from];
+    ownerIndex[to] = ownerIndex[from];
+    bounceCount[to] = bounceCount[from];
+    alive[to] = alive[from];
+}
+
+void ShellPool::resize (size_t count)
+{
+    posX.resize (count);
+    posY.resize (count);
+    prevX.resize (count);
+    prevY.resize (count);
+    startX.resize (count);
+    startY.resize (count);
+    velX.resize (count);
+    velY.resize (count);
+    maxRange.resize (count);
+    maxRangeSq.resize (count);
+    damage.resize (count);
+    ownerIndex.resize (count);
+    bounceCount.resize (count);
+    alive.resize (count);
+}
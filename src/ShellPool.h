@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Shell.h"
+#include <cstdint>
+#include <vector>
+
+// =============================================================================
+// ShellPool
+// Every live shell, stored as one array per field so the per-step integration
+// runs over packed floats four at a time. Dead shells are swap-removed, so
+// indices are only stable until the next removeDead().
+// =============================================================================
+
+class ShellPool
+{
+public:
+    size_t size() const { return posX.size(); }
+    bool empty() const { return posX.empty(); }
+
+    void clear();
+    void add (const Shell& shell);
+
+    // Copy of one shell, for obstacle collision checks
+    Shell get (size_t index) const;
+
+    Vec2 getPosition (size_t index) const           { return { posX[index], posY[index] }; }
+    Vec2 getPreviousPosition (size_t index) const   { return { prevX[index], prevY[index] }; }
+    Vec2 getVelocity (size_t index) const           { return { velX[index], velY[index] }; }
+    int getOwnerIndex (size_t index) const          { return ownerIndex[index]; }
+    float getDamage (size_t index) const            { return damage[index]; }
+    float getMaxRange (size_t index) const          { return maxRange[index]; }
+    float getRadius() const                         { return config.shellRadius; }
+    bool isAlive (size_t index) const               { return alive[index] != 0; }
+
+    Vec2 getRenderPosition (size_t index, float alpha) const
+    {
+        Vec2 prev = getPreviousPosition (index);
+        return prev + (getPosition (index) - prev) * alpha;
+    }
+
+    void kill (size_t index) { alive[index] = 0; }
+
+    // Reflection off walls - moves the shell back to where it hit, pushes it clear
+    // and gives it a fresh range
+    void reflect (size_t index, Vec2 normal, Vec2 contact);
+
+    // External force (from fan/magnet)
+    void applyForce (size_t index, Vec2 force, float dt)
+    {
+        velX[index] += force.x * dt;
+        velY[index] += force.y * dt;
+    }
+
+    // Move every shell by its velocity and kill those past their range or outside the arena
+    void integrate (float dt, float arenaWidth, float arenaHeight);
+
+    // Drop dead shells by moving the last shell into each hole
+    void removeDead();
+
+private:
+    std::vector<float> posX, posY;
+    std::vector<float> prevX, prevY;
+    std::vector<float> startX, startY;
+    std::vector<float> velX, velY;
+    std::vector<float> maxRange;
+    std::vector<float> maxRangeSq;      // Range check compares squared distance, no sqrt
+    std::vector<float> damage;
+    std::vector<int> ownerIndex;
+    std::vector<int> bounceCount;
+    std::vector<uint8_t> alive;
+
+    void integrateScalar (size_t begin, size_t end, float dt, float arenaWidth, float arenaHeight);
+    void moveShell (size_t from, size_t to);
+    void resize (size_t count);
+};
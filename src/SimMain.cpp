@@ -0,0 +1,307 @@
+#include "Config.h"
+#include "MatchRunner.h"
+#include "Random.h"
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+using json = nlohmann::json;
+
+// =============================================================================
+// cambrai-sim
+// Runs AI-vs-AI matches headless across every core and writes the results as
+// JSON or CSV, for checking balance changes without watching games.
+// =============================================================================
+
+namespace
+{
+    struct Options
+    {
+        int matches = 100;
+        int threads = 0;            // 0 = one per hardware thread
+        uint64_t seed = 0;
+        bool haveSeed = false;
+        std::string configPath;
+        std::string jsonPath;
+        std::string csvPath;
+        MatchSettings settings;
+    };
+
+    void printUsage()
+    {
+        std::fprintf (stderr,
+            "Usage: cambrai-sim [options]\n"
+            "  --matches <n>         Matches to run (default 100)\n"
+            "  --threads <n>         Worker threads (default: all cores)\n"
+            "  --seed <n>            Base seed, each match derives its own from it\n"
+            "  --config <file>       Config JSON to run with (default: built-in values)\n"
+            "  --rounds <n>          Rounds per match (default: config roundsToWin)\n"
+            "  --arena <w>x<h>       Arena size (default 1280x720)\n"
+            "  --max-round-time <s>  End a round that runs longer than this (default 600)\n"
+            "  --json <file>         Write results as JSON ('-' for stdout, the default)\n"
+            "  --csv <file>          Write results as CSV ('-' for stdout)\n");
+    }
+
+    bool parseOptions (int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--matches" && hasValue)
+                options.matches = std::max (1, std::atoi (argv[++i]));
+            else if (arg == "--threads" && hasValue)
+                options.threads = std::max (0, std::atoi (argv[++i]));
+            else if (arg == "--seed" && hasValue)
+            {
+                options.seed = std::strtoull (argv[++i], nullptr, 0);
+                options.haveSeed = true;
+            }
+            else if (arg == "--config" && hasValue)
+                options.configPath = argv[++i];
+            else if (arg == "--rounds" && hasValue)
+                options.settings.rounds = std::max (1, std::atoi (argv[++i]));
+            else if (arg == "--arena" && hasValue)
+            {
+                int w = 0, h = 0;
+                if (std::sscanf (argv[++i], "%dx%d", &w, &h) != 2 || w <= 0 || h <= 0)
+                    return false;
+                options.settings.arenaWidth = (float) w;
+                options.settings.arenaHeight = (float) h;
+            }
+            else if (arg == "--max-round-time" && hasValue)
+                options.settings.maxRoundTime = (float) std::atof (argv[++i]);
+            else if (arg == "--json" && hasValue)
+                options.jsonPath = argv[++i];
+            else if (arg == "--csv" && hasValue)
+                options.csvPath = argv[++i];
+            else
+                return false;
+        }
+
+        if (options.jsonPath.empty() && options.csvPath.empty())
+            options.jsonPath = "-";
+
+        return true;
+    }
+
+    bool loadConfig (const std::string& path)
+    {
+        std::ifstream file (path);
+        if (! file.is_open())
+            return false;
+
+        std::string text ((std::istreambuf_iterator<char> (file)), std::istreambuf_iterator<char>());
+        return config.fromJson (text);
+    }
+
+    bool writeOutput (const std::string& path, const std::string& text)
+    {
+        if (path == "-")
+        {
+            std::fwrite (text.data(), 1, text.size(), stdout);
+            return true;
+        }
+
+        std::ofstream file (path);
+        if (! file.is_open())
+            return false;
+
+        file << text;
+        return file.good();
+    }
+
+    double ticksPerSecond (uint64_t ticks, double seconds)
+    {
+        return seconds > 0.0 ? ticks / seconds : 0.0;
+    }
+
+    std::string toJson (const Options& options, int threads, const std::vector<MatchResult>& results, double wallSeconds)
+    {
+        json j;
+        j["seed"] = options.seed;
+        j["matches"] = results.size();
+        j["threads"] = threads;
+        j["wallSeconds"] = wallSeconds;
+
+        uint64_t totalTicks = 0;
+        std::array<int, World::MAX_TANKS> wins = {};
+        int draws = 0;
+
+        json matches = json::array();
+        for (size_t m = 0; m < results.size(); ++m)
+        {
+            const MatchResult& r = results[m];
+            totalTicks += r.ticks;
+            if (r.winner >= 0)
+                wins[r.winner]++;
+            else
+                draws++;
+
+            json rounds = json::array();
+            for (const auto& round : r.rounds)
+            {
+                rounds.push_back ({
+                    { "winner", round.winner },
+                    { "duration", round.duration },
+                    { "kills", round.kills }
+                });
+            }
+
+            matches.push_back ({
+                { "match", m },
+                { "seed", r.seed },
+                { "winner", r.winner },
+                { "scores", r.scores },
+                { "rounds", rounds },
+                { "ticks", r.ticks },
+                { "wallSeconds", r.wallSeconds },
+                { "ticksPerSecond", ticksPerSecond (r.ticks, r.wallSeconds) }
+            });
+        }
+
+        j["ticks"] = totalTicks;
+        j["ticksPerSecond"] = ticksPerSecond (totalTicks, wallSeconds);
+        j["wins"] = wins;
+        j["draws"] = draws;
+        j["results"] = matches;
+
+        return j.dump (2) + "\n";
+    }
+
+    std::string toCsv (const std::vector<MatchResult>& results)
+    {
+        std::string csv = "match,seed,winner";
+        for (int i = 1; i <= World::MAX_TANKS; ++i)
+            csv += ",score_p" + std::to_string (i);
+        for (int i = 1; i <= World::MAX_TANKS; ++i)
+            csv += ",kills_p" + std::to_string (i);
+        csv += ",round_winners,round_kills,ticks,ticks_per_sec,wall_seconds\n";
+
+        for (size_t m = 0; m < results.size(); ++m)
+        {
+            const MatchResult& r = results[m];
+
+            std::array<int, World::MAX_TANKS> totalKills = {};
+            std::string roundWinners, roundKills;
+
+            for (size_t n = 0; n < r.rounds.size(); ++n)
+            {
+                const RoundResult& round = r.rounds[n];
+                if (n > 0)
+                {
+                    roundWinners += " ";
+                    roundKills += " ";
+                }
+                roundWinners += std::to_string (round.winner);
+
+                // Kills per player within a round are separated by '/'
+                for (int i = 0; i < World::MAX_TANKS; ++i)
+                {
+                    totalKills[i] += round.kills[i];
+                    roundKills += (i > 0 ? "/" : "") + std::to_string (round.kills[i]);
+                }
+            }
+
+            csv += std::to_string (m) + "," + std::to_string (r.seed) + "," + std::to_string (r.winner);
+            for (int score : r.scores)
+                csv += "," + std::to_string (score);
+            for (int kills : totalKills)
+                csv += "," + std::to_string (kills);
+
+            char timing[96];
+            std::snprintf (timing, sizeof (timing), ",%llu,%.0f,%.4f\n", (unsigned long long) r.ticks,
+                           ticksPerSecond (r.ticks, r.wallSeconds), r.wallSeconds);
+
+            csv += "," + roundWinners + "," + roundKills + timing;
+        }
+
+        return csv;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    Options options;
+    if (! parseOptions (argc, argv, options))
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (! options.configPath.empty() && ! loadConfig (options.configPath))
+    {
+        std::fprintf (stderr, "Unable to read config: %s\n", options.configPath.c_str());
+        return 1;
+    }
+
+    if (! options.haveSeed)
+        options.seed = Random::makeSeed();
+
+    int threads = options.threads > 0 ? options.threads : (int) std::thread::hardware_concurrency();
+    threads = std::clamp (threads, 1, options.matches);
+
+    // Workers pull match indices from a shared counter and write into their own result slot.
+    // Config is only read from here on, so nothing else is shared.
+    std::vector<MatchResult> results (options.matches);
+    std::atomic<int> nextMatch { 0 };
+    std::atomic<int> completed { 0 };
+    Random seeds (options.seed);
+
+    auto worker = [&]
+    {
+        for (int m = nextMatch++; m < options.matches; m = nextMatch++)
+        {
+            results[m] = runMatch (seeds.at ((uint64_t) m), options.settings);
+            completed++;
+        }
+    };
+
+    std::fprintf (stderr, "Running %d matches on %d threads (seed %llu)\n",
+                  options.matches, threads, (unsigned long long) options.seed);
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> pool;
+    pool.reserve (threads);
+    for (int i = 0; i < threads; ++i)
+        pool.emplace_back (worker);
+
+    for (auto& thread : pool)
+        thread.join();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    double wallSeconds = elapsed.count();
+
+    uint64_t totalTicks = 0;
+    for (const auto& r : results)
+        totalTicks += r.ticks;
+
+    std::fprintf (stderr, "%d matches, %llu ticks in %.2f s (%.0f ticks/s)\n", completed.load(),
+                  (unsigned long long) totalTicks, wallSeconds, ticksPerSecond (totalTicks, wallSeconds));
+
+    bool ok = true;
+    if (! options.jsonPath.empty())
+        ok = writeOutput (options.jsonPath, toJson (options, threads, results, wallSeconds)) && ok;
+    if (! options.csvPath.empty())
+        ok = writeOutput (options.csvPath, toCsv (results)) && ok;
+
+    if (! ok)
+    {
+        std::fprintf (stderr, "Unable to write results\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,19 +1,44 @@
 #include "Tank.h"
 #include "Config.h"
-#include "Random.h"
 #include <algorithm>
 #include <cmath>
 
-Tank::Tank (int playerIndex_, Vec2 startPos, float startAngle, float tankSize)
+namespace
+{
+    // Blend two angles along the shortest arc
+    float lerpAngle (float from, float to, float alpha)
+    {
+        float diff = to - from;
+        while (diff > pi)
+            diff -= 2.0f * pi;
+        while (diff < -pi)
+            diff += 2.0f * pi;
+        return from + diff * alpha;
+    }
+}
+
+Tank::Tank (int playerIndex_, Vec2 startPos, float startAngle, float tankSize, Random cosmeticRandom_, ParticleSystem& particles_)
     : playerIndex (playerIndex_), position (startPos), angle (startAngle),
-      turretAngle (0.0f), size (tankSize)
+      turretAngle (0.0f), size (tankSize),
+      previousPosition (startPos), previousAngle (startAngle), previousTurretAngle (0.0f),
+      particles (particles_), cosmeticRandom (cosmeticRandom_)
 {
     crosshairOffset = Vec2::fromAngle (angle) * config.crosshairStartDistance;
     reloadTimer = config.fireInterval; // Start loaded
+
+    // Tank is square-ish but slightly longer than wide
+    float halfSize = size / 2.0f;
+    hull.halfSize = { halfSize * 1.2f, halfSize * 0.8f };
+    hull.setAngle (angle);
+    hull.moveTo (position);
 }
 
 void Tank::update (float dt, Vec2 moveInput, Vec2 aimInput, bool fireInput, float arenaWidth, float arenaHeight)
 {
+    previousPosition = position;
+    previousAngle = angle;
+    previousTurretAngle = turretAngle;
+
     // Handle destruction animation
     if (destroying)
     {
@@ -25,7 +50,7 @@ void Tank::update (float dt, Vec2 moveInput, Vec2 aimInput, bool fireInput, floa
         velocity *= 0.95f;
         position += velocity * dt;
         clampToArena (arenaWidth, arenaHeight);
-        updateSmoke (dt);
+        emitSmoke (dt);
         return;
     }
 
@@ -75,7 +100,7 @@ void Tank::update (float dt, Vec2 moveInput, Vec2 aimInput, bool fireInput, floa
             crosshairOffset = crosshairOffset.normalized() * config.crosshairMaxDistance;
 
         updateTurret (dt);
-        updateSmoke (dt);
+        emitSmoke (dt);
         return;
     }
 
@@ -167,8 +192,8 @@ void Tank::update (float dt, Vec2 moveInput, Vec2 aimInput, bool fireInput, floa
     updateTurret (dt);
 
     // Update effects
-    updateTrackMarks (dt);
-    updateSmoke (dt);
+    emitTrackMarks (dt);
+    emitSmoke (dt);
 }
 
 void Tank::updateTurret (float dt)
@@ -237,9 +262,20 @@ bool Tank::isTurretOnTarget() const
     return angleDiff <= config.turretOnTargetTolerance;
 }
 
+void Tank::updateHull()
+{
+    if (angle != hull.angle)
+        hull.setAngle (angle);
+
+    hull.moveTo (position);
+}
+
 void Tank::clampToArena (float arenaWidth, float arenaHeight)
 {
-    auto corners = getCorners();
+    // Every step that moves the tank ends here, so this is where the hull catches up
+    updateHull();
+
+    const auto& corners = hull.corners;
 
     float pushLeft = 0.0f, pushRight = 0.0f, pushUp = 0.0f, pushDown = 0.0f;
 
@@ -276,9 +312,12 @@ void Tank::clampToArena (float arenaWidth, float arenaHeight)
         position.y -= pushDown;
         velocity.y = -std::abs (velocity.y) * config.wallBounceMultiplier;
     }
+
+    if (pushLeft > 0 || pushRight > 0 || pushUp > 0 || pushDown > 0)
+        hull.moveTo (position);
 }
 
-Color Tank::getColor() const
+Color Tank::getPlayerColor (int playerIndex)
 {
     switch (playerIndex)
     {
@@ -323,34 +362,60 @@ void Tank::applyCollision (Vec2 pushDirection, float pushDistance, Vec2 impulse)
 {
     position += pushDirection * pushDistance;
     velocity += impulse;
+    hull.moveTo (position);
 }
 
-std::array<Vec2, 4> Tank::getCorners() const
+bool Tank::checkHitLine (Vec2 lineStart, Vec2 lineEnd, Vec2& hitPoint) const
 {
-    float halfSize = size / 2.0f;
+    // Line-circle intersection test
+    // Tank is approximated as a circle with radius = size * 0.6
+    float radius = size * 0.6f;
 
-    float cosA = std::cos (angle);
-    float sinA = std::sin (angle);
+    Vec2 d = lineEnd - lineStart;
+    Vec2 f = lineStart - position;
 
-    // Tank is square-ish but slightly longer than wide
-    float halfLength = halfSize * 1.2f;
-    float halfWidth = halfSize * 0.8f;
-
-    Vec2 corners[4] = {
-        { -halfLength, -halfWidth },
-        { halfLength, -halfWidth },
-        { halfLength, halfWidth },
-        { -halfLength, halfWidth }
-    };
-
-    std::array<Vec2, 4> worldCorners;
-    for (int i = 0; i < 4; ++i)
+    float a = d.dot (d);
+    float b = 2.0f * f.dot (d);
+    float c = f.dot (f) - radius * radius;
+
+    float discriminant = b * b - 4.0f * a * c;
+    if (discriminant < 0)
+        return false;
+
+    discriminant = std::sqrt (discriminant);
+
+    // Find the nearest intersection point along the line segment
+    float t1 = (-b - discriminant) / (2.0f * a);
+    float t2 = (-b + discriminant) / (2.0f * a);
+
+    // Check if either intersection is within the line segment [0, 1]
+    if (t1 >= 0.0f && t1 <= 1.0f)
+    {
+        hitPoint = lineStart + d * t1;
+        return true;
+    }
+    if (t2 >= 0.0f && t2 <= 1.0f)
     {
-        worldCorners[i].x = position.x + corners[i].x * cosA - corners[i].y * sinA;
-        worldCorners[i].y = position.y + corners[i].x * sinA + corners[i].y * cosA;
+        hitPoint = lineStart + d * t2;
+        return true;
     }
 
-    return worldCorners;
+    return false;
+}
+
+bool Tank::checkTankCollision (const Tank& other, Vec2& collisionPoint) const
+{
+    Vec2 diff = other.position - position;
+    float dist = diff.length();
+    float combinedRadius = (size + other.size) * 0.5f;
+
+    if (dist < combinedRadius)
+    {
+        collisionPoint = position + diff * 0.5f;
+        return true;
+    }
+
+    return false;
 }
 
 bool Tank::fireShell()
@@ -386,45 +451,23 @@ void Tank::setCrosshairPosition (Vec2 worldPos)
     }
 }
 
-void Tank::updateTrackMarks (float dt)
+void Tank::emitTrackMarks (float dt)
 {
-    float fadeRate = 1.0f / config.trackMarkFadeTime;
-
-    // Fade existing track marks
-    for (auto it = trackMarks.begin(); it != trackMarks.end();)
-    {
-        it->alpha -= fadeRate * dt;
-        if (it->alpha <= 0.0f)
-            it = trackMarks.erase (it);
-        else
-            ++it;
-    }
-
     // Spawn new track marks based on distance traveled
     float speed = velocity.length();
     if (isAlive() && speed > 0.1f)
     {
         trackMarkDistance += speed * dt;
-        if (trackMarkDistance >= config.trackMarkSpawnDistance)
+        if (trackMarkDistance >= config.trackMarkSpawnDistance * particles.getDensity().trackMarkSpacingScale)
         {
             trackMarkDistance = 0.0f;
-            trackMarks.push_back ({ position, angle, 1.0f });
+            particles.emitTrackMark ({ position, angle, size });
         }
     }
 }
 
-void Tank::updateSmoke (float dt)
+void Tank::emitSmoke (float dt)
 {
-    // Fade existing smoke
-    for (auto it = smoke.begin(); it != smoke.end();)
-    {
-        it->alpha -= it->fadeRate * dt;
-        if (it->alpha <= 0.0f)
-            it = smoke.erase (it);
-        else
-            ++it;
-    }
-
     // Spawn smoke when damaged or destroying
     float damagePercent = getDamagePercent();
     float destroyFactor = destroying ? (1.0f - getDestroyProgress()) : 1.0f;
@@ -436,7 +479,8 @@ void Tank::updateSmoke (float dt)
     {
         smokeSpawnTimer += dt;
 
-        float spawnInterval = config.smokeBaseSpawnInterval / ((1.0f + damagePercent * config.smokeDamageMultiplier) * destroyFactor);
+        float spawnInterval = config.smokeBaseSpawnInterval * particles.getDensity().smokeIntervalScale
+                              / ((1.0f + damagePercent * config.smokeDamageMultiplier) * destroyFactor);
 
         while (smokeSpawnTimer >= spawnInterval)
         {
@@ -447,21 +491,21 @@ void Tank::updateSmoke (float dt)
             // Random offset on damaged/destroying tanks
             if (damagePercent > 0.3f || destroying)
             {
-                float randomX = randomFloat (-0.5f, 0.5f) * size * 0.6f;
-                float randomY = randomFloat (-0.5f, 0.5f) * size * 0.6f;
+                float randomX = cosmeticRandom.nextFloat (-0.5f, 0.5f) * size * 0.6f;
+                float randomY = cosmeticRandom.nextFloat (-0.5f, 0.5f) * size * 0.6f;
                 spawnPos.x += randomX;
                 spawnPos.y += randomY;
             }
 
             float baseRadius = config.smokeBaseRadius + damagePercent * 3.0f;
-            float smokeRadius = baseRadius + randomFloat() * 2.0f;
+            float smokeRadius = baseRadius + cosmeticRandom.nextFloat() * 2.0f;
 
             float startAlpha = (config.smokeBaseAlpha + damagePercent * 0.4f) * destroyFactor;
 
-            float lifetime = randomFloat (config.smokeFadeTimeMin, config.smokeFadeTimeMax);
+            float lifetime = cosmeticRandom.nextFloat (config.smokeFadeTimeMin, config.smokeFadeTimeMax);
             float fadeRate = 1.0f / lifetime;
 
-            smoke.push_back ({ spawnPos, smokeRadius, startAlpha, fadeRate });
+            particles.emitSmoke ({ spawnPos, smokeRadius, startAlpha, fadeRate });
         }
     }
 }
@@ -482,9 +526,26 @@ void Tank::startTeleportCooldown (float duration)
     teleportCooldown = duration;
 }
 
+Vec2 Tank::getRenderPosition (float alpha) const
+{
+    return previousPosition + (position - previousPosition) * alpha;
+}
+
+float Tank::getRenderAngle (float alpha) const
+{
+    return lerpAngle (previousAngle, angle, alpha);
+}
+
+float Tank::getRenderTurretAngle (float alpha) const
+{
+    return lerpAngle (previousTurretAngle, turretAngle, alpha);
+}
+
 void Tank::teleportTo (Vec2 newPosition)
 {
     position = newPosition;
+    previousPosition = newPosition;  // Don't smear the jump across the render interpolation
+    hull.moveTo (position);
     // Maintain velocity/speed through portal
     startTeleportCooldown (config.portalCooldown);
 }
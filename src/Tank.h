@@ -1,31 +1,19 @@
 #pragma once
 
 #include "Config.h"
+#include "Geometry.h"
+#include "ParticleSystem.h"
+#include "Random.h"
 #include "Shell.h"
 #include "Vec2.h"
 #include <raylib.h>
 #include <array>
 #include <vector>
 
-struct Smoke
-{
-    Vec2 position;
-    float radius;
-    float alpha;
-    float fadeRate;
-};
-
-struct TrackMark
-{
-    Vec2 position;
-    float angle;
-    float alpha;
-};
-
 class Tank
 {
 public:
-    Tank (int playerIndex, Vec2 startPos, float startAngle, float tankSize);
+    Tank (int playerIndex, Vec2 startPos, float startAngle, float tankSize, Random cosmeticRandom, ParticleSystem& particles);
 
     void update (float dt, Vec2 moveInput, Vec2 aimInput, bool fireInput, float arenaWidth, float arenaHeight);
 
@@ -37,11 +25,15 @@ public:
     int getPlayerIndex() const                      { return playerIndex; }
     Vec2 getCrosshairPosition() const               { return position + crosshairOffset; }
     void setCrosshairPosition (Vec2 worldPos);
-    const std::vector<Smoke>& getSmoke() const      { return smoke; }
-    const std::vector<TrackMark>& getTrackMarks() const { return trackMarks; }
     float getDamagePercent() const                  { return 1.0f - (health / config.tankMaxHealth); }
     std::vector<Shell>& getPendingShells()          { return pendingShells; }
-    Color getColor() const;
+    Color getColor() const                          { return getPlayerColor (playerIndex); }
+    static Color getPlayerColor (int playerIndex);
+
+    // Render state blended between the previous and current simulation step (alpha 0..1)
+    Vec2 getRenderPosition (float alpha) const;
+    float getRenderAngle (float alpha) const;
+    float getRenderTurretAngle (float alpha) const;
 
     // Health system
     float getHealth() const         { return health; }
@@ -72,7 +64,11 @@ public:
     Vec2 getVelocity() const        { return velocity; }
     float getSpeed() const          { return velocity.length(); }
     void applyCollision (Vec2 pushDirection, float pushDistance, Vec2 impulse);
-    std::array<Vec2, 4> getCorners() const;
+    const OrientedBox& getHull() const              { return hull; }
+    const std::array<Vec2, 4>& getCorners() const   { return hull.corners; }
+    Bounds getBounds() const        { return Bounds::around (position, size); }  // Covers the hull and hit circle at any angle
+    bool checkHitLine (Vec2 lineStart, Vec2 lineEnd, Vec2& hitPoint) const;
+    bool checkTankCollision (const Tank& other, Vec2& collisionPoint) const;
 
     // HUD info
     float getThrottle() const       { return throttle; }
@@ -89,15 +85,23 @@ private:
     float turretAngle = 0.0f;       // Turret angle relative to body
     float size;
 
+    // Hull in world space, kept up to date whenever the tank moves or turns
+    OrientedBox hull;
+
+    // State at the start of the last step, for render interpolation
+    Vec2 previousPosition;
+    float previousAngle = 0.0f;
+    float previousTurretAngle = 0.0f;
+
     float throttle = 0.0f;          // -1 to 1 (current throttle)
     float reloadTimer = 0.0f;       // Time since last shot
 
     Vec2 crosshairOffset;           // Offset from tank position
 
-    std::vector<Smoke> smoke;
+    ParticleSystem& particles;      // Smoke and track marks are emitted here
     float smokeSpawnTimer = 0.0f;
+    Random cosmeticRandom;          // Smoke jitter - never affects gameplay
 
-    std::vector<TrackMark> trackMarks;
     float trackMarkDistance = 0.0f;  // Distance traveled since last track mark
 
     // Health
@@ -119,9 +123,10 @@ private:
     // Shooting
     std::vector<Shell> pendingShells;
 
+    void updateHull();
     void clampToArena (float arenaWidth, float arenaHeight);
-    void updateSmoke (float dt);
-    void updateTrackMarks (float dt);
+    void emitSmoke (float dt);
+    void emitTrackMarks (float dt);
     void updateTurret (float dt);
     bool fireShell();
 };
@@ -1,9 +1,10 @@
 #if defined(_WIN32)
 
 #include <windows.h>
+#include <stdlib.h>
 
 // Forward declaration - defined in main.cpp
-int runGame();
+int runGame (int argc, char* argv[]);
 
 int WINAPI WinMain (HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
 {
@@ -12,7 +13,7 @@ int WINAPI WinMain (HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLin
     (void) lpCmdLine;
     (void) nCmdShow;
 
-    return runGame();
+    return runGame (__argc, __argv);
 }
 
 #endif
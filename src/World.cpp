@@ -0,0 +1,848 @@
+#include "World.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace
+{
+    // How far along the shell's path this step a hit happened, 0 at the start and 1 at the end
+    float getImpactFraction (Vec2 start, Vec2 path, Vec2 point)
+    {
+        float lengthSquared = path.lengthSquared();
+        if (lengthSquared <= 0.0f)
+            return 0.0f;
+
+        return std::clamp ((point - start).dot (path) / lengthSquared, 0.0f, 1.0f);
+    }
+}
+
+World::World (float arenaWidth_, float arenaHeight_, uint64_t seed)
+    : arenaWidth (arenaWidth_), arenaHeight (arenaHeight_), random (seed)
+{
+    createAIControllers();
+}
+
+World::~World() = default;
+
+void World::setArenaSize (float width, float height)
+{
+    arenaWidth = width;
+    arenaHeight = height;
+}
+
+void World::reset (uint64_t seed)
+{
+    random = MatchRandom (seed);
+    createAIControllers();
+
+    for (auto& tank : tanks)
+        tank.reset();
+
+    shells.clear();
+    particles.clear();
+    obstacles.clear();
+    obstacleTreeStale = true;
+    forceField.invalidate();
+    events.clear();
+
+    scores = {};
+    kills = {};
+    roundOver = false;
+    roundWinner = -1;
+    startPositionOrder = { 0, 1, 2, 3 };
+}
+
+void World::prepareRound (bool clearObstacles)
+{
+    // Shuffle starting positions
+    for (int i = MAX_TANKS - 1; i > 0; --i)
+    {
+        int j = random.gameplay.nextInt (i + 1);
+        std::swap (startPositionOrder[i], startPositionOrder[j]);
+    }
+
+    // Create tanks at randomized starting positions
+    for (int i = 0; i < MAX_TANKS; ++i)
+    {
+        int posIndex = startPositionOrder[i];
+        tanks[i] = std::make_unique<Tank> (i, getTankStartPosition (posIndex), getTankStartAngle (posIndex), TANK_SIZE,
+                                           Random (random.cosmetic.nextU64()), particles);
+    }
+
+    shells.clear();
+    particles.clear();
+
+    if (clearObstacles)
+    {
+        obstacles.clear();
+    }
+    else
+    {
+        // Remove destroyed obstacles (mines that exploded, breakable walls that were destroyed)
+        obstacles.removeDead();
+    }
+
+    obstacleTreeStale = true;
+    forceField.invalidate();
+}
+
+void World::startRound()
+{
+    roundTime = 0.0f;
+    roundOver = false;
+    roundWinner = -1;
+
+    // Reset kills for this round
+    kills = {};
+
+    // Reset stalemate detection
+    noDamageTimer = 0.0f;
+    for (int i = 0; i < MAX_TANKS; ++i)
+        lastTankHealth[i] = tanks[i] ? tanks[i]->getHealth() : 0.0f;
+
+    // Everything's been placed
+    rebuildObstacleTree();
+}
+
+// =============================================================================
+// Placement
+// =============================================================================
+
+bool World::isValidPlacement (ObstacleType type, Vec2 position, float angle, int ownerIndex) const
+{
+    auto temp = createObstacle (type, position, angle, ownerIndex);
+    return temp->isValidPlacement (obstacles.getAll(), getTankPointers (false), arenaWidth, arenaHeight);
+}
+
+bool World::placeObstacle (ObstacleType type, Vec2 position, float angle, int ownerIndex)
+{
+    if (! isValidPlacement (type, position, angle, ownerIndex))
+        return false;
+
+    obstacles.add (type, position, angle, ownerIndex).onPlaced (random.gameplay);
+    obstacleTreeStale = true;
+    forceField.invalidate();
+    return true;
+}
+
+bool World::placeObstacleRandomly (ObstacleType type, int ownerIndex, int attempts)
+{
+    AIController& ai = *aiControllers[ownerIndex];
+
+    for (int attempt = 0; attempt < attempts; ++attempt)
+    {
+        Vec2 pos = ai.getPlacementPosition (arenaWidth, arenaHeight);
+        float angle = ai.getPlacementAngle();
+
+        if (placeObstacle (type, pos, angle, ownerIndex))
+            return true;
+    }
+    return false;
+}
+
+// =============================================================================
+// Simulation
+// =============================================================================
+
+void World::update (float dt, const std::array<TankInput, MAX_TANKS>& inputs)
+{
+    events.clear();
+
+    if (roundOver)
+        return;
+
+    roundTime += dt;
+
+    if (obstacleTreeStale)
+        rebuildObstacleTree();
+
+    updateSight();
+    updateTanks (dt, inputs);
+    updateObstacles (dt);
+    if (removeDeadFromObstacleTree())
+        sightStale = true;
+    updateShells (dt);
+    checkCollisions();
+    particles.update (dt);
+
+    // Update stalemate timer
+    noDamageTimer += dt;
+
+    checkRoundOver();
+}
+
+void World::updateRoundOver (float dt)
+{
+    events.clear();
+
+    // Keep updating tanks for smoke effects
+    for (auto& tank : tanks)
+    {
+        if (tank && tank->isVisible())
+            tank->update (dt, { 0, 0 }, { 0, 0 }, false, arenaWidth, arenaHeight);
+    }
+
+    particles.update (dt);
+}
+
+void World::updateTanks (float dt, const std::array<TankInput, MAX_TANKS>& inputs)
+{
+    for (int tankIdx = 0; tankIdx < MAX_TANKS; ++tankIdx)
+    {
+        Tank* tank = tanks[tankIdx].get();
+        if (! tank || ! tank->isVisible())
+            continue;
+
+        const TankInput& input = inputs[tankIdx];
+
+        Vec2 moveInput, aimInput;
+        bool fireInput = false;
+
+        if (input.aiControlled)
+        {
+            std::vector<const Tank*> enemies;
+            for (int j = 0; j < MAX_TANKS; ++j)
+                if (j != tankIdx && tanks[j] && tanks[j]->isAlive())
+                    enemies.push_back (tanks[j].get());
+
+            AIController& ai = *aiControllers[tankIdx];
+            ai.update (dt, *tank, enemies, getSightMask (tankIdx), shells, obstacles.getAll(), obstacleTree, arenaWidth, arenaHeight);
+            moveInput = ai.getMoveInput();
+            aimInput = ai.getAimInput();
+            fireInput = ai.getFireInput();
+        }
+        else
+        {
+            moveInput = input.move;
+            aimInput = input.aim;
+            fireInput = (roundTime > config.roundStartDelay) && input.fire;
+        }
+
+        tank->update (dt, moveInput, aimInput, fireInput, arenaWidth, arenaHeight);
+
+        // Mouse aiming
+        if (! input.aiControlled && input.hasCrosshairTarget)
+            tank->setCrosshairPosition (input.crosshairTarget);
+
+        // Collect shells
+        auto& pendingShells = tank->getPendingShells();
+        if (! pendingShells.empty())
+            events.push_back ({ WorldEvent::Type::CannonFired, tank->getPosition() });
+
+        for (const auto& shell : pendingShells)
+            shells.add (shell);
+
+        pendingShells.clear();
+    }
+}
+
+void World::updateObstacles (float dt)
+{
+    std::vector<Tank*> tankPtrs = getTankPointers (true);
+
+    // Walls and pits have nothing to do per step, so their buckets are skipped
+    updateObstacleBucket<Mine> (dt, tankPtrs);
+    updateObstacleBucket<AutoTurret> (dt, tankPtrs);
+    updateObstacleBucket<Portal> (dt, tankPtrs);
+    updateObstacleBucket<Flag> (dt, tankPtrs);
+    updateObstacleBucket<HealthPack> (dt, tankPtrs);
+    updateObstacleBucket<Electromagnet> (dt, tankPtrs);
+    updateObstacleBucket<Fan> (dt, tankPtrs);
+
+    // Apply obstacle forces to tanks (electromagnet, fan)
+    forceField.update (obstacles.getAll(), arenaWidth, arenaHeight);
+    if (! forceField.isEmpty())
+    {
+        for (auto& tank : tanks)
+        {
+            if (tank && tank->isAlive())
+                tank->applyExternalForce (forceField.getTankForce (tank->getPosition()));
+        }
+    }
+}
+
+template <typename T>
+void World::updateObstacleBucket (float dt, const std::vector<Tank*>& tankPtrs)
+{
+    for (T& obstacle : obstacles.getBucket<T>())
+    {
+        obstacle.update (dt, tankPtrs, arenaWidth, arenaHeight);
+
+        // Collect shells from auto turrets
+        if constexpr (std::is_same_v<T, AutoTurret>)
+        {
+            auto& pendingShells = obstacle.getPendingShells();
+            for (const auto& shell : pendingShells)
+                shells.add (shell);
+            pendingShells.clear();
+        }
+
+        // Handle collection effects (flag capture, health pack pickup)
+        if constexpr (std::is_same_v<T, Flag> || std::is_same_v<T, HealthPack>)
+        {
+            auto effect = obstacle.consumeCollectionEffect();
+            if (effect.playerIndex >= 0 && effect.playerIndex < MAX_TANKS)
+            {
+                scores[effect.playerIndex] += effect.scoreToAdd;
+                if (effect.healthPercent > 0 && tanks[effect.playerIndex])
+                    tanks[effect.playerIndex]->heal (effect.healthPercent);
+            }
+        }
+    }
+}
+
+void World::rebuildObstacleTree()
+{
+    obstacleBounds.resize (obstacles.size());
+
+    for (size_t i = 0; i < obstacles.size(); ++i)
+    {
+        Obstacle& obstacle = obstacles[i];
+        if (! obstacle.isAlive())
+        {
+            obstacleBounds[i] = Bounds::empty();
+            continue;
+        }
+
+        obstacleBounds[i] = ObstacleStore::visit (obstacles.getType (i), obstacle, [] (auto& o) { return o.getBounds(); });
+    }
+
+    obstacleTree.build (obstacleBounds);
+    obstacleTreeStale = false;
+    sightStale = true;
+}
+
+bool World::removeDeadFromObstacleTree()
+{
+    // Just an alive flag per obstacle, no bounds are recomputed
+    bool removed = false;
+
+    for (size_t i = 0; i < obstacles.size(); ++i)
+    {
+        if (! obstacles[i].isAlive() && obstacleTree.contains ((int) i))
+        {
+            obstacleTree.remove ((int) i);
+            removed = true;
+        }
+    }
+
+    return removed;
+}
+
+// =============================================================================
+// Sight
+// =============================================================================
+
+bool World::raycast (Vec2 start, Vec2 end, RayHit& hit) const
+{
+    hit = {};
+
+    obstacleTree.querySegment (start, end, 0.0f, rayCandidates);
+
+    for (int index : rayCandidates)
+    {
+        const Obstacle& obstacle = obstacles[(size_t) index];
+        if (! obstacle.isAlive() || ! obstacle.isRectangular())
+            continue;
+
+        float fraction;
+        Vec2 normal;
+        if (static_cast<const Wall&> (obstacle).raycast (start, end, fraction, normal)
+            && (hit.obstacleIndex < 0 || fraction < hit.fraction))
+        {
+            hit.obstacleIndex = index;
+            hit.fraction = fraction;
+            hit.normal = normal;
+        }
+    }
+
+    if (hit.obstacleIndex < 0)
+        return false;
+
+    hit.point = start + (end - start) * hit.fraction;
+    return true;
+}
+
+bool World::hasLineOfSight (Vec2 from, Vec2 to) const
+{
+    // Any wall will do, so there's no need to find the nearest
+    obstacleTree.querySegment (from, to, 0.0f, rayCandidates);
+
+    float fraction;
+    Vec2 normal;
+
+    for (int index : rayCandidates)
+    {
+        const Obstacle& obstacle = obstacles[(size_t) index];
+        if (obstacle.isAlive() && obstacle.isRectangular()
+            && static_cast<const Wall&> (obstacle).raycast (from, to, fraction, normal))
+            return false;
+    }
+
+    return true;
+}
+
+bool World::canTankSee (int viewerIndex, int targetIndex) const
+{
+    return (getSightMask (viewerIndex) >> targetIndex) & 1;
+}
+
+bool World::canTurretSee (int obstacleIndex, int targetIndex) const
+{
+    if (obstacleIndex < 0 || obstacleIndex >= (int) sightTurretRows.size() || sightTurretRows[(size_t) obstacleIndex] < 0)
+        return false;
+
+    return (getSightMask (sightTurretRows[(size_t) obstacleIndex]) >> targetIndex) & 1;
+}
+
+uint32_t World::getSightMask (int row) const
+{
+    size_t first = (size_t) row * MAX_TANKS;
+    if (first + MAX_TANKS > sightMatrix.size())
+        return 0;
+
+    uint32_t mask = 0;
+    for (int target = 0; target < MAX_TANKS; ++target)
+        if (sightMatrix[first + (size_t) target])
+            mask |= 1u << target;
+
+    return mask;
+}
+
+void World::updateSight()
+{
+    // Tanks first, then turrets - tanks that are gone keep a row so the indices line up
+    sightPoints.clear();
+    for (const auto& tank : tanks)
+        sightPoints.push_back (tank ? tank->getPosition() : Vec2());
+
+    sightTurretRows.assign (obstacles.size(), -1);
+    for (size_t i = 0; i < obstacles.size(); ++i)
+    {
+        if (obstacles.getType (i) == ObstacleType::AutoTurret)
+        {
+            sightTurretRows[i] = (int) sightPoints.size();
+            sightPoints.push_back (obstacles[i].getPosition());
+        }
+    }
+
+    size_t rows = sightPoints.size();
+    if (sightStale || sightPointsTested.size() != rows)
+    {
+        sightMatrix.assign (rows * MAX_TANKS, 0);
+        sightPointsTested.clear();
+    }
+
+    // Tanks move after this, so allow for a tank coming into range during the step
+    float turretSightRange = config.turretRange + TANK_SIZE;
+    float turretRangeSquared = turretSightRange * turretSightRange;
+
+    auto isActive = [&] (size_t row)
+    {
+        if (row < MAX_TANKS)
+            return tanks[row] && tanks[row]->isAlive();
+        return true;
+    };
+
+    auto hasMoved = [&] (size_t row)
+    {
+        if (row >= sightPointsTested.size())
+            return true;
+
+        return sightPoints[row].x != sightPointsTested[row].x || sightPoints[row].y != sightPointsTested[row].y;
+    };
+
+    for (size_t viewer = 0; viewer < rows; ++viewer)
+    {
+        for (size_t target = 0; target < MAX_TANKS; ++target)
+        {
+            uint8_t& visible = sightMatrix[viewer * MAX_TANKS + target];
+
+            if (viewer == target || ! isActive (viewer) || ! isActive (target))
+                visible = 0;
+            else if (viewer >= MAX_TANKS && (sightPoints[target] - sightPoints[viewer]).lengthSquared() > turretRangeSquared)
+                visible = 0;    // Turrets ignore anything out of range, so there's no point looking
+            else if (viewer < MAX_TANKS && target < viewer)
+                visible = sightMatrix[target * MAX_TANKS + viewer];     // Sight between tanks goes both ways
+            else if (hasMoved (viewer) || hasMoved (target))
+                visible = hasLineOfSight (sightPoints[viewer], sightPoints[target]) ? 1 : 0;
+        }
+    }
+
+    sightPointsTested = sightPoints;
+    sightStale = false;
+
+    // Turrets only pick from the tanks they can see
+    for (size_t i = 0; i < obstacles.size(); ++i)
+        if (sightTurretRows[i] >= 0)
+            static_cast<AutoTurret&> (obstacles[i]).setVisibleTargets (getSightMask (sightTurretRows[i]));
+}
+
+void World::updateShells (float dt)
+{
+    // Apply forces from obstacles (fans, electromagnets)
+    if (! forceField.isEmpty())
+    {
+        for (size_t i = 0; i < shells.size(); ++i)
+        {
+            if (shells.isAlive (i))
+                shells.applyForce (i, forceField.getShellForce (shells.getPosition (i)), dt);
+        }
+    }
+
+    // Shells killed by last step's collisions are moved too, but dropped straight after
+    shells.integrate (dt, arenaWidth, arenaHeight);
+    shells.removeDead();
+}
+
+void World::checkCollisions()
+{
+    // Shell-to-obstacle collisions. Ricochets append to the pool - leave the new
+    // shells until next step, they spawn touching the wall and would split again
+    // straight away
+    size_t shellCount = shells.size();
+    for (size_t shellIdx = 0; shellIdx < shellCount; ++shellIdx)
+    {
+        if (!shells.isAlive (shellIdx))
+            continue;
+
+        // Only the obstacles whose bounds this step's path crosses
+        Shell shell = shells.get (shellIdx);
+        Vec2 shellPrev = shell.getPreviousPosition();
+        Vec2 shellPath = shell.getPosition() - shellPrev;
+        obstacleTree.querySegment (shellPrev, shell.getPosition(), shell.getRadius(), candidates);
+
+        // Every obstacle's test is swept along the path, so the hit is whichever the
+        // shell reached first rather than whichever was checked first. Ties go to
+        // the lower index
+        Obstacle* obstacle = nullptr;
+        ShellHitResult result = ShellHitResult::Miss;
+        Vec2 collisionPoint, normal;
+        float firstImpact = 0.0f;
+
+        for (int index : candidates)
+        {
+            Obstacle& candidate = obstacles[index];
+            if (!candidate.isAlive())
+                continue;
+
+            Vec2 candidatePoint, candidateNormal;
+            ShellHitResult candidateResult = ObstacleStore::visit (obstacles.getType (index), candidate, [&] (auto& o)
+            {
+                return o.checkShellCollision (shell, candidatePoint, candidateNormal);
+            });
+
+            if (candidateResult == ShellHitResult::Miss)
+                continue;
+
+            float impact = getImpactFraction (shellPrev, shellPath, candidatePoint);
+            if (obstacle && impact >= firstImpact)
+                continue;
+
+            obstacle = &candidate;
+            result = candidateResult;
+            collisionPoint = candidatePoint;
+            normal = candidateNormal;
+            firstImpact = impact;
+        }
+
+        if (obstacle)
+        {
+            if (result == ShellHitResult::Reflected)
+            {
+                shells.reflect (shellIdx, normal, collisionPoint);
+            }
+            else if (result == ShellHitResult::Ricochet)
+            {
+                // Create 5 shells with spread angles
+                Vec2 shellVel = shell.getVelocity();
+                float speed = shellVel.length();
+
+                // Reflect base velocity
+                float dot = shellVel.dot (normal);
+                Vec2 reflectedVel = shellVel - normal * (2.0f * dot);
+                float baseAngle = std::atan2 (reflectedVel.y, reflectedVel.x);
+
+                int ownerIndex = shell.getOwnerIndex();
+                float range = shell.getMaxRange() * 0.5f;
+                float damage = shell.getDamage() * 0.4f;
+                shells.kill (shellIdx);
+
+                // Spawn 5 shells with angles spread around the reflected direction
+                float spreadAngles[5] = { -0.3f, -0.15f, 0.0f, 0.15f, 0.3f };
+                for (int i = 0; i < 5; ++i)
+                {
+                    float angle = baseAngle + spreadAngles[i];
+                    Vec2 newVel = { std::cos (angle) * speed, std::sin (angle) * speed };
+                    Vec2 spawnPos = collisionPoint + normal * 5.0f;
+                    shells.add (Shell (spawnPos, newVel, ownerIndex, range, damage));
+                }
+            }
+            else  // Destroyed
+            {
+                // Damage destructible obstacles (breakable walls, turrets)
+                obstacle->takeDamage (shell.getDamage());
+
+                if (obstacle->createsExplosionOnHit())
+                {
+                    addExplosion (collisionPoint, config.explosionDuration, config.explosionMaxRadius);
+
+                    if (!obstacle->isAlive())
+                        addExplosion (obstacle->getPosition(), config.destroyExplosionDuration, config.destroyExplosionMaxRadius);
+
+                    events.push_back ({ WorldEvent::Type::Explosion, collisionPoint });
+                }
+
+                shells.kill (shellIdx);
+            }
+        }
+    }
+
+    // Shell-to-tank collisions (raycast along shell path)
+    for (size_t shellIdx = 0; shellIdx < shells.size(); ++shellIdx)
+    {
+        if (!shells.isAlive (shellIdx))
+            continue;
+
+        Vec2 shellPrev = shells.getPreviousPosition (shellIdx);
+        Vec2 shellCur = shells.getPosition (shellIdx);
+        Bounds shellPath = Bounds::ofSegment (shellPrev, shellCur, shells.getRadius());
+
+        for (auto& tank : tanks)
+        {
+            if (!tank || !tank->isVisible() || !shellPath.overlaps (tank->getBounds()))
+                continue;
+
+            Vec2 hitPoint;
+            if (tank->checkHitLine (shellPrev, shellCur, hitPoint))
+            {
+                int ownerIndex = shells.getOwnerIndex (shellIdx);
+                tank->takeDamage (shells.getDamage (shellIdx), ownerIndex);
+
+                addExplosion (hitPoint, config.explosionDuration, config.explosionMaxRadius);
+                events.push_back ({ WorldEvent::Type::Explosion, hitPoint });
+
+                if (!tank->isAlive())
+                    awardKill (ownerIndex, *tank);
+
+                shells.kill (shellIdx);
+                break;
+            }
+        }
+    }
+
+    // Tank-to-obstacle collisions
+    for (auto& tank : tanks)
+    {
+        if (!tank || !tank->isAlive())
+            continue;
+
+        Bounds queried = tank->getBounds();
+        obstacleTree.query (queried, candidates);
+
+        for (size_t c = 0; c < candidates.size(); ++c)
+        {
+            // Bounds are checked against where the tank is now, a push or a portal may
+            // just have moved it, so look the rest up again from there
+            if (c > 0 && tank->getBounds() != queried)
+            {
+                int last = candidates[c - 1];
+                queried = tank->getBounds();
+                obstacleTree.query (queried, candidates);
+                c = (size_t) (std::upper_bound (candidates.begin(), candidates.end(), last) - candidates.begin());
+                if (c >= candidates.size())
+                    break;
+            }
+
+            int obstacleIdx = candidates[c];
+            Obstacle* obstacle = &obstacles[obstacleIdx];
+            if (!obstacle->isAlive())
+                continue;
+
+            Vec2 pushDir;
+            float pushDist;
+
+            bool hit = ObstacleStore::visit (obstacles.getType (obstacleIdx), *obstacle, [&] (auto& o)
+            {
+                return o.checkTankCollision (*tank, pushDir, pushDist);
+            });
+
+            if (! hit)
+                continue;
+
+            if (obstacle->getType() == ObstacleType::Mine && obstacle->isArmed())
+            {
+                // Mine explodes - instant kill
+                tank->takeDamage (config.mineDamage, obstacle->getOwnerIndex());
+                obstacle->takeDamage (9999.0f);
+
+                addExplosion (obstacle->getPosition(), config.destroyExplosionDuration, config.destroyExplosionMaxRadius);
+                events.push_back ({ WorldEvent::Type::Explosion, obstacle->getPosition() });
+
+                if (!tank->isAlive())
+                    awardKill (obstacle->getOwnerIndex(), *tank);
+            }
+            else
+            {
+                // Let obstacle handle collision (pit traps, portal teleports, etc.)
+                bool applyPush = obstacle->handleTankCollision (*tank, obstacles.getAll(), random.gameplay);
+
+                if (applyPush)
+                {
+                    tank->applyCollision (pushDir, pushDist, { 0, 0 });
+                    events.push_back ({ WorldEvent::Type::Collision, tank->getPosition() });
+                }
+            }
+        }
+    }
+
+    // Tank-to-tank collisions
+    for (int i = 0; i < MAX_TANKS; ++i)
+    {
+        if (!tanks[i] || !tanks[i]->isAlive())
+            continue;
+
+        for (int j = i + 1; j < MAX_TANKS; ++j)
+        {
+            if (!tanks[j] || !tanks[j]->isAlive())
+                continue;
+
+            Vec2 collisionPoint;
+            if (tanks[i]->checkTankCollision (*tanks[j], collisionPoint))
+            {
+                Vec2 diff = tanks[j]->getPosition() - tanks[i]->getPosition();
+                Vec2 normal = diff.normalized();
+
+                float pushDist = (tanks[i]->getSize() + tanks[j]->getSize()) * 0.3f;
+
+                Vec2 velA = tanks[i]->getVelocity();
+                Vec2 velB = tanks[j]->getVelocity();
+                Vec2 relVel = velA - velB;
+                float impulseStrength = relVel.dot (normal) * 0.5f * config.collisionRestitution;
+
+                Vec2 impulse = normal * impulseStrength;
+
+                tanks[i]->applyCollision (normal * -1.0f, pushDist, impulse * -1.0f);
+                tanks[j]->applyCollision (normal, pushDist, impulse);
+
+                // Collision damage
+                float impactSpeed = relVel.length();
+                float damage = impactSpeed * config.collisionDamageScale;
+                tanks[i]->takeDamage (damage, j);
+                tanks[j]->takeDamage (damage, i);
+
+                // Track kills from ramming
+                if (!tanks[i]->isAlive())
+                    awardKill (j, *tanks[i]);
+                if (!tanks[j]->isAlive())
+                    awardKill (i, *tanks[j]);
+
+                if (impactSpeed > config.audioMinImpactForSound)
+                    events.push_back ({ WorldEvent::Type::Collision, collisionPoint });
+            }
+        }
+    }
+}
+
+void World::checkRoundOver()
+{
+    int aliveCount = 0;
+    int lastAlive = -1;
+
+    // Check for damage taken (stalemate detection)
+    bool damageTaken = false;
+    for (int i = 0; i < MAX_TANKS; ++i)
+    {
+        if (tanks[i] && tanks[i]->isAlive() && !tanks[i]->isDestroying())
+        {
+            aliveCount++;
+            lastAlive = i;
+
+            float currentHealth = tanks[i]->getHealth();
+            if (currentHealth < lastTankHealth[i])
+                damageTaken = true;
+            lastTankHealth[i] = currentHealth;
+        }
+    }
+
+    if (damageTaken)
+        noDamageTimer = 0.0f;
+
+    if (aliveCount <= 1)
+    {
+        roundWinner = lastAlive;
+
+        // Award survival point
+        if (roundWinner >= 0)
+            scores[roundWinner] += config.pointsForSurviving;
+
+        roundOver = true;
+    }
+    // Stalemate - no damage for too long
+    else if (noDamageTimer >= config.stalemateTimeout)
+    {
+        roundWinner = -1;  // Draw
+        roundOver = true;
+    }
+}
+
+void World::addExplosion (Vec2 position, float duration, float maxRadius)
+{
+    particles.emitExplosion (position, duration, maxRadius);
+}
+
+void World::awardKill (int attackerIndex, const Tank& victim)
+{
+    // No points for self-kills
+    if (attackerIndex < 0 || attackerIndex >= MAX_TANKS || attackerIndex == victim.getPlayerIndex())
+        return;
+
+    kills[attackerIndex]++;
+    scores[attackerIndex] += config.pointsForKill;
+
+    // Big explosion for destruction
+    addExplosion (victim.getPosition(), config.destroyExplosionDuration, config.destroyExplosionMaxRadius);
+}
+
+void World::createAIControllers()
+{
+    for (int i = 0; i < MAX_TANKS; ++i)
+        aiControllers[i] = std::make_unique<AIController> (random.ai.fork (i));
+}
+
+std::vector<Tank*> World::getTankPointers (bool aliveOnly) const
+{
+    std::vector<Tank*> tankPtrs;
+    for (auto& tank : tanks)
+        if (tank && (! aliveOnly || tank->isAlive()))
+            tankPtrs.push_back (tank.get());
+    return tankPtrs;
+}
+
+Vec2 World::getTankStartPosition (int index) const
+{
+    // Place tanks in corners
+    float margin = 100.0f;
+
+    switch (index)
+    {
+        case 0: return { margin, margin };
+        case 1: return { arenaWidth - margin, margin };
+        case 2: return { margin, arenaHeight - margin };
+        case 3: return { arenaWidth - margin, arenaHeight - margin };
+        default: return { arenaWidth / 2.0f, arenaHeight / 2.0f };
+    }
+}
+
+float World::getTankStartAngle (int index) const
+{
+    // Point tanks toward center
+    switch (index)
+    {
+        case 0: return pi * 0.25f;   // Top-left, point toward center
+        case 1: return pi * 0.75f;   // Top-right
+        case 2: return -pi * 0.25f;  // Bottom-left
+        case 3: return -pi * 0.75f;  // Bottom-right
+        default: return 0.0f;
+    }
+}
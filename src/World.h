@@ -0,0 +1,180 @@
+#pragma once
+
+#include "AIController.h"
+#include "Config.h"
+#include "ForceField.h"
+#include "Obstacles/AllObstacles.h"
+#include "Obstacles/ObstacleStore.h"
+#include "ObstacleTree.h"
+#include "ParticleSystem.h"
+#include "Random.h"
+#include "ShellPool.h"
+#include "Tank.h"
+#include <array>
+#include <memory>
+#include <vector>
+
+// Controls for one tank for a single simulation step
+struct TankInput
+{
+    bool aiControlled = true;           // Let the world's AIController drive this tank
+    Vec2 move;
+    Vec2 aim;
+    bool fire = false;
+    bool hasCrosshairTarget = false;    // Mouse aiming - snap crosshair to a world position
+    Vec2 crosshairTarget;
+};
+
+// Something that happened during a step that the presentation layer may want to react to
+struct WorldEvent
+{
+    enum class Type
+    {
+        CannonFired,
+        Explosion,
+        Collision
+    };
+
+    Type type;
+    Vec2 position;
+};
+
+// The first wall a ray runs into
+struct RayHit
+{
+    int obstacleIndex = -1;     // Into getObstacles()
+    Vec2 point;
+    Vec2 normal;                // Of the face the ray came through
+    float fraction = 1.0f;      // How far along the ray, 0 at its start and 1 at its end
+};
+
+// =============================================================================
+// World
+// Owns everything that takes part in the simulation. Has no dependency on a
+// window, audio device or renderer so it can be stepped headless.
+// =============================================================================
+
+class World
+{
+public:
+    static constexpr int MAX_TANKS = 4;
+    static constexpr float TANK_SIZE = 40.0f;
+
+    World (float arenaWidth, float arenaHeight, uint64_t seed);
+    ~World();
+
+    void setArenaSize (float width, float height);
+    float getArenaWidth() const { return arenaWidth; }
+    float getArenaHeight() const { return arenaHeight; }
+
+    // Match flow
+    void reset (uint64_t seed);                // Clear everything and reseed for a new match
+    void prepareRound (bool clearObstacles);   // Shuffle start positions, spawn tanks
+    void startRound();
+    void update (float dt, const std::array<TankInput, MAX_TANKS>& inputs);
+    void updateRoundOver (float dt);           // Let destroyed tanks and explosions play out
+
+    bool isRoundOver() const { return roundOver; }
+    int getRoundWinner() const { return roundWinner; }
+    float getRoundTime() const { return roundTime; }
+
+    // Placement
+    bool isValidPlacement (ObstacleType type, Vec2 position, float angle, int ownerIndex) const;
+    bool placeObstacle (ObstacleType type, Vec2 position, float angle, int ownerIndex);
+    bool placeObstacleRandomly (ObstacleType type, int ownerIndex, int attempts);
+
+    // State access
+    Tank* getTank (int index) const { return tanks[index].get(); }
+    AIController& getAIController (int index) { return *aiControllers[index]; }
+    const ShellPool& getShells() const { return shells; }
+    const ParticleSystem& getParticles() const { return particles; }
+    void setEffectDensity (const EffectDensity& density) { particles.setDensity (density); }
+    const ObstacleList& getObstacles() const { return obstacles.getAll(); }
+    int getScore (int playerIndex) const { return scores[playerIndex]; }
+    int getKills (int playerIndex) const { return kills[playerIndex]; }
+
+    // Sight - only walls block rays, and the obstacle broadphase is only current
+    // once a round has started
+    bool raycast (Vec2 start, Vec2 end, RayHit& hit) const;
+    bool hasLineOfSight (Vec2 from, Vec2 to) const;
+
+    // Whether one tank could see another, or an auto turret (by its index in
+    // getObstacles()) a tank, at the start of the last step
+    bool canTankSee (int viewerIndex, int targetIndex) const;
+    bool canTurretSee (int obstacleIndex, int targetIndex) const;
+
+    // Randomness for this match
+    uint64_t getSeed() const { return random.seed; }
+    Random& getAIRandom() { return random.ai; }
+
+    // Events raised during the last update
+    const std::vector<WorldEvent>& getEvents() const { return events; }
+
+private:
+    float arenaWidth;
+    float arenaHeight;
+
+    MatchRandom random;
+
+    std::array<std::unique_ptr<Tank>, MAX_TANKS> tanks;
+    std::array<std::unique_ptr<AIController>, MAX_TANKS> aiControllers;
+    ShellPool shells;
+    ParticleSystem particles;
+    ObstacleStore obstacles;
+    std::vector<WorldEvent> events;
+
+    // Scoring
+    std::array<int, MAX_TANKS> scores = {};  // Total points
+    std::array<int, MAX_TANKS> kills = {};   // Kills this round
+
+    // Round state
+    float roundTime = 0.0f;
+    bool roundOver = false;
+    int roundWinner = -1;
+
+    // Stalemate detection
+    float noDamageTimer = 0.0f;
+    std::array<float, MAX_TANKS> lastTankHealth = {};
+
+    // Random starting positions (shuffled each round)
+    std::array<int, MAX_TANKS> startPositionOrder = { 0, 1, 2, 3 };
+
+    // Broadphase - obstacles don't move, so the tree is built when the set changes
+    // and dead obstacles are taken out of it as they're found
+    ObstacleTree obstacleTree;
+    std::vector<Bounds> obstacleBounds;
+    bool obstacleTreeStale = true;
+    std::vector<int> candidates;            // Scratch for tree queries
+    mutable std::vector<int> rayCandidates;
+
+    // Visibility between tanks and from each auto turret to each tank, refreshed
+    // once per step. Viewers are the tanks, then the turrets in bucket order, and
+    // each row holds a flag per tank. A pair is only retested when one of its ends
+    // has moved since it was last tested, or when a wall has gone
+    std::vector<Vec2> sightPoints;
+    std::vector<Vec2> sightPointsTested;
+    std::vector<int> sightTurretRows;       // Row per obstacle index, -1 for anything that isn't a turret
+    std::vector<uint8_t> sightMatrix;
+    bool sightStale = true;
+
+    ForceField forceField;
+
+    void updateTanks (float dt, const std::array<TankInput, MAX_TANKS>& inputs);
+    void updateObstacles (float dt);
+    template <typename T> void updateObstacleBucket (float dt, const std::vector<Tank*>& tankPtrs);
+    void rebuildObstacleTree();
+    bool removeDeadFromObstacleTree();
+    void updateSight();
+    uint32_t getSightMask (int row) const;
+    void updateShells (float dt);
+    void checkCollisions();
+    void checkRoundOver();
+
+    void addExplosion (Vec2 position, float duration, float maxRadius);
+    void awardKill (int attackerIndex, const Tank& victim);
+    std::vector<Tank*> getTankPointers (bool aliveOnly) const;
+    void createAIControllers();
+
+    Vec2 getTankStartPosition (int index) const;
+    float getTankStartAngle (int index) const;
+};
@@ -1,11 +1,57 @@
 #include "Config.h"
 #include "Game.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
-int runGame()
+namespace
 {
-    config.startWatching();
+    void printUsage()
+    {
+        std::printf ("Usage: Cambrai [--replay <file> [--uncapped] [--render-every <n>] [--no-render]]\n");
+    }
+
+    bool parseOptions (int argc, char* argv[], GameOptions& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+
+            if (std::strcmp (arg, "--replay") == 0 && i + 1 < argc)
+                options.replayPath = argv[++i];
+            else if (std::strcmp (arg, "--uncapped") == 0)
+                options.uncapped = true;
+            else if (std::strcmp (arg, "--render-every") == 0 && i + 1 < argc)
+                options.renderEvery = std::max (1, std::atoi (argv[++i]));
+            else if (std::strcmp (arg, "--no-render") == 0)
+                options.noRender = true;
+            else
+                return false;
+        }
+
+        // Headless runs have no input, so they only make sense for a replay
+        if (options.noRender && options.replayPath.empty())
+            return false;
+
+        return true;
+    }
+}
+
+int runGame (int argc, char* argv[])
+{
+    GameOptions options;
+    if (! parseOptions (argc, argv, options))
+    {
+        printUsage();
+        return 1;
+    }
 
-    Game game;
+    // Replays carry their own config snapshot, don't let the file on disk change it mid-playback
+    if (options.replayPath.empty())
+        config.startWatching();
+
+    Game game (options);
 
     if (! game.init())
     {
@@ -22,10 +68,7 @@ int runGame()
 
 int main (int argc, char* argv[])
 {
-    (void) argc;
-    (void) argv;
-
-    return runGame();
+    return runGame (argc, argv);
 }
 
 #endif
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+
+// =============================================================================
+// Check
+// Just enough for cambrai-tests. CHECK records a failure with where it
+// happened and carries on, so one run reports every broken case.
+// =============================================================================
+
+namespace Check
+{
+    inline int checks = 0;
+    inline int failures = 0;
+
+    inline void record (bool passed, const char* expression, const char* file, int line)
+    {
+        checks++;
+        if (passed)
+            return;
+
+        // Random cases can fail thousands of times, the first few say enough
+        if (failures++ < 20)
+            std::printf ("%s:%d: failed: %s\n", file, line, expression);
+    }
+
+    // Same bits - so 0 and -0 differ - rather than just equal
+    inline bool sameBits (float a, float b)
+    {
+        return std::memcmp (&a, &b, sizeof (float)) == 0;
+    }
+}
+
+#define CHECK(expression) Check::record ((expression), #expression, __FILE__, __LINE__)
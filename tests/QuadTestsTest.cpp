@@ -0,0 +1,167 @@
+#include "Check.h"
+#include "QuadTests.h"
+#include <random>
+
+using namespace QuadTests;
+
+namespace
+{
+    OrientedBox makeBox (Vec2 centre, float angle, Vec2 halfSize)
+    {
+        OrientedBox box;
+        box.halfSize = halfSize;
+        box.setAngle (angle);
+        box.moveTo (centre);
+        return box;
+    }
+
+    // The vector versions against the scalar ones, which have to agree to the bit
+    void compareCrossing (Vec2 start, Vec2 end, const Quad& corners)
+    {
+        int edge = -1, scalarEdge = -1;
+        Vec2 point, scalarPoint;
+        bool crossed = firstEdgeCrossing (start, end, corners, edge, point);
+        bool scalarCrossed = firstEdgeCrossingScalar (start, end, corners, scalarEdge, scalarPoint);
+
+        CHECK (crossed == scalarCrossed);
+        if (crossed && scalarCrossed)
+        {
+            CHECK (edge == scalarEdge);
+            CHECK (Check::sameBits (point.x, scalarPoint.x));
+            CHECK (Check::sameBits (point.y, scalarPoint.y));
+        }
+    }
+
+    void compareContains (const Quad& corners, Vec2 point)
+    {
+        CHECK (contains (corners, point) == containsScalar (corners, point));
+    }
+
+    void compareOverlap (const OrientedBox& a, const OrientedBox& b)
+    {
+        Vec2 axis, scalarAxis;
+        float depth = 0.0f, scalarDepth = 0.0f;
+        bool overlapping = overlap (a, b, axis, depth);
+        bool scalarOverlapping = overlapScalar (a, b, scalarAxis, scalarDepth);
+
+        CHECK (overlapping == scalarOverlapping);
+        if (overlapping && scalarOverlapping)
+        {
+            CHECK (Check::sameBits (depth, scalarDepth));
+            CHECK (Check::sameBits (axis.x, scalarAxis.x));
+            CHECK (Check::sameBits (axis.y, scalarAxis.y));
+        }
+    }
+
+    // Cases with known answers, on an axis aligned box with corners (50, 90), (150, 90), (150, 110), (50, 110)
+    void testEdgeCases()
+    {
+        OrientedBox box = makeBox ({ 100, 100 }, 0.0f, { 50, 10 });
+        const Quad& corners = box.corners;
+        int edge;
+        Vec2 point;
+
+        // Straight through - the near edge is the hit
+        compareCrossing ({ 100, 0 }, { 100, 200 }, corners);
+        CHECK (firstEdgeCrossing ({ 100, 0 }, { 100, 200 }, corners, edge, point));
+        CHECK (edge == 0 && point.x == 100.0f && point.y == 90.0f);
+
+        // Through the (50, 90) corner - touching doesn't count, so it's the edge it leaves by
+        compareCrossing ({ 0, 40 }, { 100, 140 }, corners);
+        CHECK (firstEdgeCrossing ({ 0, 40 }, { 100, 140 }, corners, edge, point));
+        CHECK (edge == 2 && point.x == 70.0f && point.y == 110.0f);
+
+        // Along an edge, ending just past both of its corners
+        compareCrossing ({ 0, 90 }, { 200, 90 }, corners);
+        CHECK (! firstEdgeCrossing ({ 0, 90 }, { 200, 90 }, corners, edge, point));
+
+        // Not moving, inside and outside
+        compareCrossing ({ 100, 100 }, { 100, 100 }, corners);
+        compareCrossing ({ 0, 0 }, { 0, 0 }, corners);
+        CHECK (! firstEdgeCrossing ({ 100, 100 }, { 100, 100 }, corners, edge, point));
+
+        // On an edge or a corner counts as inside
+        for (Vec2 p : { Vec2 (100, 90), Vec2 (150, 100), Vec2 (50, 90), Vec2 (150, 110), Vec2 (100, 100) })
+        {
+            compareContains (corners, p);
+            CHECK (contains (corners, p));
+        }
+        for (Vec2 p : { Vec2 (100, 89.99f), Vec2 (150.01f, 100), Vec2 (0, 0) })
+        {
+            compareContains (corners, p);
+            CHECK (! contains (corners, p));
+        }
+
+        Vec2 axis;
+        float depth;
+
+        // Touching along x = 150 still overlaps, by nothing
+        OrientedBox touching = makeBox ({ 200, 100 }, 0.0f, { 50, 10 });
+        compareOverlap (box, touching);
+        CHECK (overlap (box, touching, axis, depth));
+        CHECK (depth == 0.0f);
+
+        // Nested - the shallowest way out is across the thin side
+        OrientedBox nested = makeBox ({ 100, 100 }, 0.0f, { 10, 5 });
+        compareOverlap (box, nested);
+        compareOverlap (nested, box);
+        CHECK (overlap (box, nested, axis, depth));
+        CHECK (depth == 15.0f && axis.x == 0.0f && axis.y == 1.0f);
+
+        // Apart, and apart only on the turned box's own axes
+        OrientedBox apart = makeBox ({ 400, 100 }, 0.0f, { 50, 10 });
+        compareOverlap (box, apart);
+        CHECK (! overlap (box, apart, axis, depth));
+
+        OrientedBox diagonal = makeBox ({ 175, 135 }, 0.785398f, { 20, 5 });
+        compareOverlap (box, diagonal);
+        compareOverlap (diagonal, box);
+    }
+
+    void testRandomCases()
+    {
+        std::mt19937 rng (12345);
+        std::uniform_real_distribution<float> position (0.0f, 1000.0f);
+        std::uniform_real_distribution<float> angle (-4.0f, 4.0f);
+        std::uniform_real_distribution<float> size (1.0f, 120.0f);
+        std::uniform_real_distribution<float> offset (-40.0f, 40.0f);
+        std::uniform_real_distribution<float> fraction (0.0f, 1.0f);
+        std::uniform_int_distribution<int> variant (0, 7);
+
+        for (int n = 0; n < 200000; ++n)
+        {
+            Vec2 centre = { position (rng), position (rng) };
+            OrientedBox a = makeBox (centre, angle (rng), { size (rng), size (rng) });
+
+            // Sometimes lined up with a, which gives exact ties between axes
+            float angleB = variant (rng) == 0 ? a.angle : angle (rng);
+            OrientedBox b = makeBox (centre + Vec2 (offset (rng) * 3.0f, offset (rng) * 3.0f), angleB, { size (rng), size (rng) });
+
+            Vec2 start = centre + Vec2 (offset (rng) * 2.0f, offset (rng) * 2.0f);
+            Vec2 end = start + Vec2 (offset (rng), offset (rng));
+
+            int corner = variant (rng) % 4;
+            switch (variant (rng))
+            {
+                case 0: start = a.corners[corner]; break;                                              // From a corner
+                case 1: end = a.corners[corner]; break;                                                // To a corner
+                case 2: start = a.corners[corner]; end = a.corners[(corner + 1) % 4]; break;           // Along an edge
+                case 3: end = start; break;                                                            // Not moving
+                case 4: end = a.corners[corner] + (a.corners[(corner + 1) % 4] - a.corners[corner]) * fraction (rng); break;  // Onto an edge
+                default: break;
+            }
+
+            compareCrossing (start, end, a.corners);
+            compareContains (a.corners, start);
+            compareContains (a.corners, end);
+            compareOverlap (a, b);
+            compareOverlap (b, a);
+        }
+    }
+}
+
+void runQuadTests()
+{
+    testEdgeCases();
+    testRandomCases();
+}
@@ -0,0 +1,14 @@
+#include "Check.h"
+#include <cstdio>
+
+void runQuadTests();
+void runWorldTests();
+
+int main()
+{
+    runQuadTests();
+    runWorldTests();
+
+    std::printf ("%d checks, %d failed\n", Check::checks, Check::failures);
+    return Check::failures == 0 ? 0 : 1;
+}
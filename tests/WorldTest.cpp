@@ -0,0 +1,165 @@
+#include "Check.h"
+#include "Config.h"
+#include "World.h"
+#include <cmath>
+
+namespace
+{
+    bool near (float a, float b)
+    {
+        return std::abs (a - b) < 1.0e-3f;
+    }
+
+    bool near (Vec2 a, Vec2 b)
+    {
+        return near (a.x, b.x) && near (a.y, b.y);
+    }
+
+    // Tanks start in shuffled corners, so find whichever one is in this corner
+    int tankAt (const World& world, Vec2 corner)
+    {
+        for (int i = 0; i < World::MAX_TANKS; ++i)
+        {
+            if (world.getTank (i) && near (world.getTank (i)->getPosition(), corner))
+                return i;
+        }
+        return -1;
+    }
+
+    // One step, then every cached answer against a fresh ray from where things were when it started
+    void checkSightAfterStep (World& world)
+    {
+        Vec2 tankPositions[World::MAX_TANKS];
+        for (int i = 0; i < World::MAX_TANKS; ++i)
+            tankPositions[i] = world.getTank (i)->getPosition();
+
+        std::array<TankInput, World::MAX_TANKS> inputs;
+        world.update (1.0f / 60.0f, inputs);
+
+        for (int viewer = 0; viewer < World::MAX_TANKS; ++viewer)
+        {
+            for (int target = 0; target < World::MAX_TANKS; ++target)
+            {
+                if (viewer != target)
+                    CHECK (world.canTankSee (viewer, target) == world.hasLineOfSight (tankPositions[viewer], tankPositions[target]));
+            }
+        }
+
+        const auto& obstacles = world.getObstacles();
+        for (int i = 0; i < (int) obstacles.size(); ++i)
+        {
+            if (obstacles[(size_t) i]->getType() != ObstacleType::AutoTurret)
+                continue;
+
+            Vec2 turret = obstacles[(size_t) i]->getPosition();
+            for (int target = 0; target < World::MAX_TANKS; ++target)
+            {
+                bool inRange = (tankPositions[target] - turret).length() <= config.turretRange + World::TANK_SIZE;
+                CHECK (world.canTurretSee (i, target) == (inRange && world.hasLineOfSight (turret, tankPositions[target])));
+            }
+        }
+    }
+}
+
+void runWorldTests()
+{
+    World world (1280, 720, 7);
+    world.prepareRound (true);
+
+    // Indices into getObstacles() follow the order they're placed in
+    const int middleWall = 0;
+    const int topWall = 1;
+    const int breakableWall = 2;
+    const int lowerWall = 3;
+    const int blockedTurret = 4;
+    const int clearTurret = 5;
+
+    CHECK (world.placeObstacle (ObstacleType::SolidWall, { 640, 360 }, 0.0f, -1));
+    CHECK (world.placeObstacle (ObstacleType::SolidWall, { 640, 100 }, float (pi / 2), -1));
+    CHECK (world.placeObstacle (ObstacleType::BreakableWall, { 250, 100 }, float (pi / 2), -1));
+    CHECK (world.placeObstacle (ObstacleType::SolidWall, { 640, 500 }, 0.0f, -1));
+    CHECK (world.placeObstacle (ObstacleType::AutoTurret, { 400, 100 }, 0.0f, -1));
+    CHECK (world.placeObstacle (ObstacleType::AutoTurret, { 400, 250 }, 0.0f, -1));
+    CHECK (world.getObstacles().size() == 6);
+
+    world.startRound();
+
+    // Straight down onto the middle wall's top face, which is 10 above its centre
+    RayHit hit;
+    CHECK (world.raycast ({ 640, 200 }, { 640, 440 }, hit));
+    CHECK (hit.obstacleIndex == middleWall);
+    CHECK (near (hit.point, { 640, 350 }));
+    CHECK (near (hit.normal, { 0, -1 }));
+    CHECK (near (hit.fraction, 150.0f / 240.0f));
+
+    // Two walls on the ray, the nearer one wins whichever way it goes
+    CHECK (world.raycast ({ 640, 200 }, { 640, 600 }, hit));
+    CHECK (hit.obstacleIndex == middleWall);
+    CHECK (near (hit.point, { 640, 350 }));
+
+    CHECK (world.raycast ({ 640, 600 }, { 640, 200 }, hit));
+    CHECK (hit.obstacleIndex == lowerWall);
+    CHECK (near (hit.point, { 640, 510 }));
+    CHECK (near (hit.normal, { 0, 1 }));
+    CHECK (near (hit.fraction, 90.0f / 400.0f));
+
+    // Coming in from the side of the wall along the top edge
+    CHECK (world.raycast ({ 500, 80 }, { 800, 80 }, hit));
+    CHECK (hit.obstacleIndex == topWall);
+    CHECK (near (hit.point, { 630, 80 }));
+    CHECK (near (hit.normal, { -1, 0 }));
+
+    // Starting inside a wall hits it straight away, facing back along the ray
+    CHECK (world.raycast ({ 640, 360 }, { 640, 300 }, hit));
+    CHECK (hit.obstacleIndex == middleWall);
+    CHECK (hit.fraction == 0.0f);
+    CHECK (near (hit.point, { 640, 360 }));
+    CHECK (near (hit.normal, { 0, 1 }));
+
+    // Misses, including one that stops just short
+    CHECK (! world.raycast ({ 100, 300 }, { 500, 300 }, hit));
+    CHECK (hit.obstacleIndex == -1);
+    CHECK (! world.raycast ({ 640, 200 }, { 640, 340 }, hit));
+    CHECK (world.hasLineOfSight ({ 640, 200 }, { 640, 340 }));
+    CHECK (! world.hasLineOfSight ({ 640, 200 }, { 640, 440 }));
+
+    // Rays that catch a wall's corner and ones that pass it
+    for (float x = 560; x <= 720; x += 5)
+    {
+        Vec2 start { x, 200 };
+        Vec2 end { 1280 - x, 440 };
+        CHECK (world.hasLineOfSight (start, end) == ! world.raycast (start, end, hit));
+    }
+
+    const int topLeft = tankAt (world, { 100, 100 });
+    const int topRight = tankAt (world, { 1180, 100 });
+    const int bottomLeft = tankAt (world, { 100, 620 });
+    const int bottomRight = tankAt (world, { 1180, 620 });
+    CHECK (topLeft >= 0 && topRight >= 0 && bottomLeft >= 0 && bottomRight >= 0);
+    if (topLeft < 0 || topRight < 0 || bottomLeft < 0 || bottomRight < 0)
+        return;
+
+    checkSightAfterStep (world);
+
+    // The top wall splits the top row, the middle and lower walls the diagonals
+    CHECK (! world.canTankSee (topLeft, topRight));
+    CHECK (! world.canTankSee (topLeft, bottomRight));
+    CHECK (! world.canTankSee (bottomLeft, topRight));
+    CHECK (world.canTankSee (topLeft, bottomLeft));
+    CHECK (world.canTankSee (bottomLeft, bottomRight));
+    CHECK (world.canTankSee (topLeft, bottomLeft) == world.canTankSee (bottomLeft, topLeft));
+
+    // Both turrets have the top left tank in range, but one is behind the breakable wall
+    CHECK (! world.canTurretSee (blockedTurret, topLeft));
+    CHECK (world.canTurretSee (clearTurret, topLeft));
+    CHECK (! world.canTurretSee (clearTurret, bottomRight));
+
+    // Knock the wall down - it leaves the tree during the next step, and that clears the cached sight
+    world.getObstacles()[breakableWall]->takeDamage (1.0e6f);
+    CHECK (! world.getObstacles()[breakableWall]->isAlive());
+    checkSightAfterStep (world);
+    checkSightAfterStep (world);
+
+    CHECK (world.canTurretSee (blockedTurret, topLeft));
+    CHECK (! world.raycast ({ 150, 100 }, { 350, 100 }, hit));
+}